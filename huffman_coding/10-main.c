@@ -0,0 +1,51 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "heap.h"
+
+/**
+ * int_cmp - Compares two integers
+ *
+ * @p1: First pointer
+ * @p2: Second pointer
+ *
+ * Return: Difference between the two integers
+ */
+int int_cmp(void *p1, void *p2)
+{
+	int *n1, *n2;
+
+	n1 = (int *)p1;
+	n2 = (int *)p2;
+	return (*n1 - *n2);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	heap_t *heap;
+	int array[] = {
+	    34, 2, 45, 23, 76, 98, 12, 3, 54, 67, 1, 88, 43, 29, 7, 61, 39};
+	void *items[sizeof(array) / sizeof(array[0])];
+	size_t size = sizeof(array) / sizeof(array[0]);
+	size_t i;
+	int *n;
+
+	for (i = 0; i < size; ++i)
+		items[i] = &(array[i]);
+	heap = heap_build(int_cmp, items, size);
+	if (heap == NULL)
+	{
+		fprintf(stderr, "Failed to build the heap\n");
+		return (EXIT_FAILURE);
+	}
+	printf("Heap size: %lu\n", heap->size);
+	printf("Heap root: %d\n", *((int *)heap->root->data));
+	while ((n = heap_extract(heap)) != NULL)
+		printf("%d%s", *n, heap->size ? " " : "\n");
+	heap_delete(heap, NULL);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,31 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "huffman.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	char data[] = {
+		'a', 'b', 'c', 'd', 'e', 'f', 'g'
+	};
+	size_t freq[] = {
+		6, 11, 12, 13, 16, 36, 0
+	};
+	size_t size = sizeof(data) / sizeof(data[0]);
+	unsigned char lengths[sizeof(data) / sizeof(data[0])];
+	size_t i;
+
+	if (!huffman_code_lengths(freq, size, lengths))
+	{
+		fprintf(stderr, "Failed to compute code lengths\n");
+		return (EXIT_FAILURE);
+	}
+	for (i = 0; i < size; i++)
+		printf("%c: %lu -> %u bits\n", data[i], freq[i], lengths[i]);
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,47 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "huffman.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	const char *modes[] = {"raw", "huffman", "huffman, 4 streams"};
+	const char *text = "Huffman coding is a lossless data compression "
+		"algorithm. The idea is to assign variable-length codes to "
+		"input characters, lengths of the assigned codes are based on "
+		"the frequencies of corresponding characters.";
+	size_t n = strlen(text) * 20, cap = huffman_encode_bound(n), size, i;
+	uint8_t *in = malloc(n), *out = malloc(cap);
+
+	if (!in || !out)
+	{
+		free(in);
+		free(out);
+		return (EXIT_FAILURE);
+	}
+	for (i = 0; i < 20; i++)
+		memcpy(in + i * strlen(text), text, strlen(text));
+	size = huffman_encode(in, n, out, cap);
+	if (!size)
+	{
+		fprintf(stderr, "Failed to encode\n");
+		free(in);
+		free(out);
+		return (EXIT_FAILURE);
+	}
+	printf("Input: %lu bytes\n", n);
+	printf("Block: %lu bytes (%s)\n", size,
+	       modes[out[0]]);
+
+	size = huffman_encode((const uint8_t *)"abc", 3, out, cap);
+	printf("Block: %lu bytes (%s)\n", size,
+	       modes[out[0]]);
+	free(in);
+	free(out);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,42 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "huffman.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	const char *text = "this is an example of a huffman tree, "
+		"built from the frequencies of the characters of this text";
+	size_t n = strlen(text) * 10, cap = huffman_encode_bound(n), size, i;
+	uint8_t *in = malloc(n), *block = malloc(cap), *out = malloc(n);
+
+	if (!in || !block || !out)
+		goto fail;
+	for (i = 0; i < 10; i++)
+		memcpy(in + i * strlen(text), text, strlen(text));
+	size = huffman_encode(in, n, block, cap);
+	if (!size)
+		goto fail;
+	printf("Encoded %lu bytes into %lu\n", n, size);
+	printf("Decoded size: %lu\n", huffman_decoded_size(block, size));
+	if (huffman_decode(block, size, out, n) != n || memcmp(in, out, n))
+		goto fail;
+	printf("Round trip OK\n");
+	if (huffman_decode(block, size / 2, out, n) == HUFFMAN_ERROR)
+		printf("Truncated block rejected\n");
+	free(in);
+	free(block);
+	free(out);
+	return (EXIT_SUCCESS);
+fail:
+	fprintf(stderr, "Round trip failed\n");
+	free(in);
+	free(block);
+	free(out);
+	return (EXIT_FAILURE);
+}
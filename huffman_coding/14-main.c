@@ -0,0 +1,43 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "huffman.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	size_t freq[HUFFMAN_SYMBOLS] = {0};
+	unsigned char lengths[HUFFMAN_SYMBOLS];
+	huffman_code_t codes[HUFFMAN_SYMBOLS];
+	uint8_t header[HUFFMAN_LENGTHS_MAX];
+	size_t i, size;
+	int bit;
+
+	freq['a'] = 6;
+	freq['b'] = 11;
+	freq['c'] = 12;
+	freq['d'] = 13;
+	freq['e'] = 16;
+	freq['f'] = 36;
+	if (!huffman_code_lengths(freq, HUFFMAN_SYMBOLS, lengths) ||
+	    !huffman_canonical_codes(lengths, HUFFMAN_SYMBOLS, codes))
+	{
+		fprintf(stderr, "Failed to compute codes\n");
+		return (EXIT_FAILURE);
+	}
+	for (i = 0; i < HUFFMAN_SYMBOLS; i++)
+	{
+		if (!codes[i].length)
+			continue;
+		printf("%c: ", (int)i);
+		for (bit = 0; bit < codes[i].length; bit++)
+			putchar('0' + ((codes[i].bits >> bit) & 1));
+		putchar('\n');
+	}
+	size = huffman_lengths_write(lengths, HUFFMAN_SYMBOLS, header);
+	printf("Header: %lu bytes\n", size);
+	return (EXIT_SUCCESS);
+}
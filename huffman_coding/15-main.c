@@ -0,0 +1,35 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "huffman.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	size_t freq[16], i, bits, limited_bits;
+	unsigned char lengths[16], limited[16];
+
+	/* Fibonacci frequencies give the deepest possible trees */
+	freq[0] = 1;
+	freq[1] = 1;
+	for (i = 2; i < 16; i++)
+		freq[i] = freq[i - 1] + freq[i - 2];
+	if (!huffman_code_lengths(freq, 16, lengths) ||
+	    !huffman_code_lengths_limited(freq, 16, limited, 6))
+	{
+		fprintf(stderr, "Failed to compute code lengths\n");
+		return (EXIT_FAILURE);
+	}
+	for (i = 0, bits = 0, limited_bits = 0; i < 16; i++)
+	{
+		printf("%4lu: %2u bits, limited to 6: %u bits\n", freq[i],
+		       lengths[i], limited[i]);
+		bits += freq[i] * lengths[i];
+		limited_bits += freq[i] * limited[i];
+	}
+	printf("Total: %lu bits, limited: %lu bits\n", bits, limited_bits);
+	return (EXIT_SUCCESS);
+}
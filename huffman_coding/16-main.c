@@ -0,0 +1,36 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "huffman.h"
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	const char *text = "abracadabra, said the magician";
+	size_t hist[HUFFMAN_SYMBOLS], freq[HUFFMAN_SYMBOLS], size = 0, i;
+	uint16_t data[HUFFMAN_SYMBOLS];
+
+	if (!huffman_histogram((const uint8_t *)text, strlen(text), hist))
+	{
+		fprintf(stderr, "Failed to count symbols\n");
+		return (EXIT_FAILURE);
+	}
+	for (i = 1; i < HUFFMAN_SYMBOLS; i++)
+	{
+		if (!hist[i])
+			continue;
+		printf("'%c': %lu\n", (int)i, hist[i]);
+		data[size] = (uint16_t)i;
+		freq[size++] = hist[i];
+	}
+	if (!huffman_codes(data, freq, size))
+	{
+		fprintf(stderr, "Failed to build Huffman codes\n");
+		return (EXIT_FAILURE);
+	}
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,51 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "huffman.h"
+
+/**
+ * main - Entry point
+ *
+ * @ac: Arguments count
+ * @av: Arguments vector
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(int ac, char **av)
+{
+	huffman_params_t params = {0, 0, 0, NULL, 0, 0};
+	int in, out, ok;
+
+	if (ac < 4 || (strcmp(av[1], "-c") && strcmp(av[1], "-d")))
+	{
+		fprintf(stderr, "Usage: %s -c|-d input output "
+			"[block_size [threads]]\n", av[0]);
+		return (EXIT_FAILURE);
+	}
+	if (ac > 4)
+		params.block_size = strtoul(av[4], NULL, 10);
+	if (ac > 5)
+		params.threads = (unsigned int)strtoul(av[5], NULL, 10);
+	in = open(av[2], O_RDONLY);
+	out = open(av[3], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (in < 0 || out < 0)
+	{
+		perror("open");
+		return (EXIT_FAILURE);
+	}
+	if (!strcmp(av[1], "-c"))
+		ok = huffman_compress_fd(in, out, &params);
+	else
+		ok = huffman_decompress_fd(in, out, &params);
+	close(in);
+	close(out);
+	if (!ok)
+	{
+		fprintf(stderr, "Failed to %s %s\n",
+			av[1][1] == 'c' ? "compress" : "decompress", av[2]);
+		return (EXIT_FAILURE);
+	}
+	return (EXIT_SUCCESS);
+}
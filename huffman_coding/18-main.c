@@ -0,0 +1,119 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "huffman.h"
+
+#define THREADS	4
+
+/**
+ * struct buffer_s - Memory used as input or output of the stream functions
+ *
+ * @data: The bytes
+ * @size: Amount of bytes used
+ * @cap: Amount of bytes allocated
+ */
+typedef struct buffer_s
+{
+	uint8_t *data;
+	size_t size;
+	size_t cap;
+} buffer_t;
+
+/**
+ * buffer_read - reads from a buffer
+ *
+ * @ctx: The buffer
+ * @buf: Where to copy the bytes
+ * @n: Length of @buf
+ *
+ * Return: Amount of bytes copied
+ */
+size_t buffer_read(void *ctx, uint8_t *buf, size_t n)
+{
+	buffer_t *b = ctx;
+
+	if (n > b->cap - b->size)
+		n = b->cap - b->size;
+	memcpy(buf, b->data + b->size, n);
+	b->size += n;
+	return (n);
+}
+
+/**
+ * buffer_write - appends to a buffer
+ *
+ * @ctx: The buffer
+ * @buf: The bytes to append
+ * @n: Length of @buf
+ *
+ * Return: 1 on success, 0 if the buffer is full
+ */
+int buffer_write(void *ctx, const uint8_t *buf, size_t n)
+{
+	buffer_t *b = ctx;
+
+	if (n > b->cap - b->size)
+		return (0);
+	memcpy(b->data + b->size, buf, n);
+	b->size += n;
+	return (1);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	const char *words[] = {"the ", "quick ", "brown ", "fox ", "jumps ",
+			       "over ", "lazy ", "dog.\n"};
+	huffman_thread_stats_t stats[THREADS];
+	huffman_params_t params = {0, 0, THREADS, NULL, 0, 0};
+	buffer_t text, packed, unpacked;
+	size_t n = (size_t)16 << 20, i, len;
+
+	params.stats = stats;
+	text.data = malloc(n);
+	packed.data = malloc(n + n / 8);
+	unpacked.data = malloc(n);
+	if (!text.data || !packed.data || !unpacked.data)
+		return (EXIT_FAILURE);
+	for (i = 0; i < n; i += len)
+	{
+		len = strlen(words[(i * 7 + i / 5) % 8]);
+		len = len < n - i ? len : n - i;
+		memcpy(text.data + i, words[(i * 7 + i / 5) % 8], len);
+	}
+	text.size = 0;
+	text.cap = n;
+	packed.size = 0;
+	packed.cap = n + n / 8;
+	unpacked.size = 0;
+	unpacked.cap = n;
+
+	if (!huffman_compress_stream(buffer_read, &text, buffer_write, &packed,
+				     &params))
+	{
+		fprintf(stderr, "Failed to compress\n");
+		return (EXIT_FAILURE);
+	}
+	huffman_stats_print(stats, THREADS);
+	printf("%lu bytes compressed to %lu bytes\n", n, packed.size);
+	packed.cap = packed.size;
+	packed.size = 0;
+	if (!huffman_decompress_stream(buffer_read, &packed, buffer_write,
+				       &unpacked, &params))
+	{
+		fprintf(stderr, "Failed to decompress\n");
+		return (EXIT_FAILURE);
+	}
+	huffman_stats_print(stats, THREADS);
+	printf("%lu bytes decompressed, %s\n", unpacked.size,
+	       unpacked.size == n && !memcmp(text.data, unpacked.data, n) ?
+	       "identical" : "different");
+	free(text.data);
+	free(packed.data);
+	free(unpacked.data);
+	return (EXIT_SUCCESS);
+}
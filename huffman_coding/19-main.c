@@ -0,0 +1,101 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "huffman.h"
+
+/**
+ * struct buffer_s - Memory used as input or output of the stream functions
+ *
+ * @data: The bytes
+ * @size: Amount of bytes used
+ * @cap: Amount of bytes allocated
+ */
+typedef struct buffer_s
+{
+	uint8_t *data;
+	size_t size;
+	size_t cap;
+} buffer_t;
+
+/**
+ * line_read - reads one telemetry line per call, as a socket would deliver
+ * them
+ *
+ * @ctx: The buffer
+ * @buf: Where to copy the line
+ * @n: Length of @buf
+ *
+ * Return: Amount of bytes copied
+ */
+size_t line_read(void *ctx, uint8_t *buf, size_t n)
+{
+	buffer_t *b = ctx;
+	uint8_t *end = memchr(b->data + b->size, '\n', b->cap - b->size);
+	size_t len = end ? (size_t)(end - (b->data + b->size)) + 1 :
+		b->cap - b->size;
+
+	if (len > n)
+		len = n;
+	memcpy(buf, b->data + b->size, len);
+	b->size += len;
+	return (len);
+}
+
+/**
+ * buffer_write - appends to a buffer
+ *
+ * @ctx: The buffer
+ * @buf: The bytes to append
+ * @n: Length of @buf
+ *
+ * Return: 1 on success, 0 if the buffer is full
+ */
+int buffer_write(void *ctx, const uint8_t *buf, size_t n)
+{
+	buffer_t *b = ctx;
+
+	if (n > b->cap - b->size)
+		return (0);
+	memcpy(b->data + b->size, buf, n);
+	b->size += n;
+	return (1);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	uint8_t text[8192], packed[8192], unpacked[8192];
+	buffer_t in = {NULL, 0, 0}, out = {NULL, 0, sizeof(packed)};
+	buffer_t back = {NULL, 0, sizeof(unpacked)};
+	size_t n = 0;
+	int i;
+
+	for (i = 0; i < 100; i++)
+		n += sprintf((char *)text + n, "sensor=%d temp=%d.%d rpm=%d\n",
+			     i % 4, 20 + i % 7, i % 10, 1200 + (i % 5) * 50);
+	in.data = text;
+	in.cap = n;
+	out.data = packed;
+	back.data = unpacked;
+	if (!huffman_adaptive_compress(line_read, &in, buffer_write, &out))
+	{
+		fprintf(stderr, "Failed to compress\n");
+		return (EXIT_FAILURE);
+	}
+	printf("%lu bytes compressed to %lu bytes\n", n, out.size);
+	out.cap = out.size;
+	out.size = 0;
+	if (!huffman_adaptive_decompress(line_read, &out, buffer_write, &back))
+	{
+		fprintf(stderr, "Failed to decompress\n");
+		return (EXIT_FAILURE);
+	}
+	printf("%lu bytes decompressed, %s\n", back.size,
+	       back.size == n && !memcmp(text, unpacked, n) ?
+	       "identical" : "different");
+	return (EXIT_SUCCESS);
+}
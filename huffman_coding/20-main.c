@@ -0,0 +1,65 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "huffman.h"
+
+/**
+ * message - formats a sample message
+ *
+ * @buf: Where to write it
+ * @i: Index of the message
+ *
+ * Return: Length of the message
+ */
+size_t message(char *buf, int i)
+{
+	return ((size_t)sprintf(buf, "{\"id\":%d,\"user\":\"user%03d\","
+				"\"event\":\"%s\",\"status\":%d}", 1000 + i,
+				i * 37 % 1000, i % 3 ? "login" : "logout",
+				i % 7 ? 200 : 404));
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	char corpus[16384], msg[256];
+	uint8_t saved[HUFFMAN_DICT_SAVE_MAX], out[512], back[256];
+	huffman_dict_t trained, dict;
+	size_t n = 0, size, len, i;
+
+	for (i = 0; i < 200; i++)
+		n += message(corpus + n, (int)i);
+	if (!huffman_dict_train((uint8_t *)corpus, n, 1, &trained))
+	{
+		fprintf(stderr, "Failed to train\n");
+		return (EXIT_FAILURE);
+	}
+	size = huffman_dict_save(&trained, saved);
+	if (!huffman_dict_load(saved, size, &dict))
+	{
+		fprintf(stderr, "Failed to load\n");
+		return (EXIT_FAILURE);
+	}
+	printf("Table: %lu bytes\n", size);
+	for (i = 500; i < 504; i++)
+	{
+		len = message(msg, (int)i);
+		/* a byte the samples never had, coded through the escape */
+		if (i == 503)
+			msg[len - 2] = '~';
+		size = huffman_dict_encode(&dict, (uint8_t *)msg, len, out,
+					   sizeof(out));
+		printf("%s: %lu bytes, %lu with the table, %lu alone, %s\n",
+		       msg, len, size, huffman_encode((uint8_t *)msg, len,
+						      out + size,
+						      sizeof(out) - size),
+		       huffman_dict_decode(&dict, out, size, back,
+					   sizeof(back)) == len &&
+		       !memcmp(back, msg, len) ? "round trip OK" : "FAIL");
+	}
+	return (EXIT_SUCCESS);
+}
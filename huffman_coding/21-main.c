@@ -0,0 +1,59 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "huffman.h"
+
+/**
+ * report - prints the entropy estimate of a buffer and how it was coded
+ *
+ * @name: Name of the buffer
+ * @in: The buffer
+ * @n: Length of @in
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int report(const char *name, const uint8_t *in, size_t n)
+{
+	size_t freq[HUFFMAN_SYMBOLS], size;
+	uint8_t *out = malloc(huffman_encode_bound(n));
+
+	if (!out || !huffman_histogram(in, n, freq))
+	{
+		free(out);
+		return (0);
+	}
+	size = huffman_encode(in, n, out, huffman_encode_bound(n));
+	printf("%s: %lu bytes, entropy %lu bytes, block %lu bytes (%s)\n",
+	       name, n, huffman_entropy_bits(freq, HUFFMAN_SYMBOLS) / 8, size,
+	       out[0] == HUFFMAN_MODE_RAW ? "raw" : "huffman");
+	free(out);
+	return (1);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	const char *text = "It was the best of times, it was the worst of "
+		"times, it was the age of wisdom, it was the age of "
+		"foolishness";
+	uint8_t noise[4096], skewed[4096];
+	unsigned int seed = 42;
+	size_t i;
+
+	for (i = 0; i < sizeof(noise); i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		noise[i] = (uint8_t)(seed >> 16);
+		/* a quarter of the values turned into zeros */
+		skewed[i] = (uint8_t)(seed >> 16) < 64 ? 0 : noise[i];
+	}
+	if (!report("text", (const uint8_t *)text, strlen(text)) ||
+	    !report("noise", noise, sizeof(noise)) ||
+	    !report("skewed noise", skewed, sizeof(skewed)))
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,60 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "heap.h"
+#include "huffman.h"
+
+/**
+ * tree_cost - sums the coded size of every leaf of a Huffman tree
+ *
+ * @node: Root of the subtree
+ * @depth: Depth of @node
+ *
+ * Return: Sum of frequency times depth over the leaves below @node
+ */
+size_t tree_cost(const binary_tree_node_t *node, size_t depth)
+{
+	if (!node)
+		return (0);
+	if (node->left || node->right)
+		return (tree_cost(node->left, depth + 1) +
+			tree_cost(node->right, depth + 1));
+	return (((symbol_t *)node->data)->freq * depth);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	/* NUL and values past a byte are plain symbols */
+	uint16_t tokens[] = {0, 'a', 'b', 255, 256, 4095};
+	size_t counts[] = {40, 12, 9, 7, 20, 2};
+	uint16_t data[HUFFMAN_ALPHABET_MAX];
+	size_t freq[HUFFMAN_ALPHABET_MAX], cost = 0, i;
+	unsigned char lengths[HUFFMAN_ALPHABET_MAX];
+	binary_tree_node_t *root;
+
+	if (!huffman_codes(tokens, counts, sizeof(tokens) / sizeof(tokens[0])))
+		return (EXIT_FAILURE);
+	/* quantized deltas: small magnitudes are the most frequent */
+	for (i = 0; i < HUFFMAN_ALPHABET_MAX; i++)
+	{
+		data[i] = (uint16_t)i;
+		freq[i] = 1 + 1000000 / ((i + 1) * (i + 1));
+	}
+	root = huffman_tree(data, freq, HUFFMAN_ALPHABET_MAX);
+	if (!root || !huffman_code_lengths(freq, HUFFMAN_ALPHABET_MAX,
+					   lengths))
+	{
+		free_binary_tree_node(root, free);
+		return (EXIT_FAILURE);
+	}
+	for (i = 0; i < HUFFMAN_ALPHABET_MAX; i++)
+		cost += freq[i] * lengths[i];
+	printf("%d symbols: tree %lu bits, code lengths %lu bits\n",
+	       HUFFMAN_ALPHABET_MAX, tree_cost(root, 0), cost);
+	free_binary_tree_node(root, free);
+	return (EXIT_SUCCESS);
+}
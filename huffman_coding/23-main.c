@@ -0,0 +1,87 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "heap.h"
+#include "huffman.h"
+
+/**
+ * tree_depths - records the depth of every leaf of a Huffman tree
+ *
+ * @node: Root of the subtree
+ * @depth: Depth of @node
+ * @depths: Receives the depth of each leaf, indexed by its symbol
+ */
+void tree_depths(const binary_tree_node_t *node, unsigned char depth,
+		 unsigned char *depths)
+{
+	if (!node)
+		return;
+	if (node->left || node->right)
+	{
+		tree_depths(node->left, depth + 1, depths);
+		tree_depths(node->right, depth + 1, depths);
+		return;
+	}
+	depths[((symbol_t *)node->data)->data] = depth;
+}
+
+/**
+ * seconds - reads a monotonic clock
+ *
+ * Return: Time in seconds
+ */
+double seconds(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	static huffman_flat_t flat;
+	static uint16_t data[HUFFMAN_ALPHABET_MAX];
+	static size_t freq[HUFFMAN_ALPHABET_MAX];
+	unsigned char a[HUFFMAN_ALPHABET_MAX], b[HUFFMAN_ALPHABET_MAX];
+	binary_tree_node_t *root;
+	unsigned int seed = 42;
+	size_t size, i, round, same = 0;
+	double t, pointers = 0, flat_time = 0;
+
+	for (round = 0; round < 200; round++)
+	{
+		size = round % 2 ? HUFFMAN_ALPHABET_MAX : 256;
+		for (i = 0; i < size; i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			data[i] = (uint16_t)i;
+			/* skewed, with plenty of ties */
+			freq[i] = (seed >> 16) % (round % 7 + 2) *
+				(size - i) / 16;
+		}
+		t = seconds();
+		root = huffman_tree(data, freq, size);
+		pointers += seconds() - t;
+		t = seconds();
+		if (!huffman_flat_tree(data, freq, size, &flat))
+			return (EXIT_FAILURE);
+		flat_time += seconds() - t;
+		if (!root || !huffman_flat_lengths(&flat, b))
+			return (EXIT_FAILURE);
+		tree_depths(root, 0, a);
+		free_binary_tree_node(root, free);
+		for (i = 0; i < size && a[i] == b[i]; i++)
+			;
+		same += i == size;
+	}
+	printf("%lu/%lu trees with identical code lengths\n", same, round);
+	printf("pointer tree %.2f ms, flat tree %.2f ms\n",
+	       pointers * 1000, flat_time * 1000);
+	return (EXIT_SUCCESS);
+}
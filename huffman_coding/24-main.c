@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "heap.h"
+#include "huffman.h"
+
+#define COUNT	100000
+
+/**
+ * encoder - builds a Huffman tree for a message, then saves its table and
+ * codes the message with it, as the sending process would
+ *
+ * @msg: The message
+ * @saved: Receives the saved table
+ * @size: Receives the length of the saved table
+ * @coded: Receives the coded message
+ *
+ * Return: Length of the coded message, or HUFFMAN_ERROR on failure
+ */
+size_t encoder(const uint16_t *msg, uint8_t *saved, size_t *size,
+	       uint8_t *coded)
+{
+	static uint16_t data[HUFFMAN_ALPHABET_MAX];
+	static size_t freq[HUFFMAN_ALPHABET_MAX];
+	static unsigned char lengths[HUFFMAN_ALPHABET_MAX];
+	static huffman_table_t table;
+	binary_tree_node_t *root;
+	size_t i, bytes;
+	int ok;
+
+	for (i = 0; i < HUFFMAN_ALPHABET_MAX; i++)
+	{
+		data[i] = (uint16_t)i;
+		freq[i] = 0;
+	}
+	for (i = 0; i < COUNT; i++)
+		freq[msg[i]]++;
+	root = huffman_tree(data, freq, HUFFMAN_ALPHABET_MAX);
+	ok = root && huffman_tree_lengths(root, lengths);
+	free_binary_tree_node(root, free);
+	if (!ok || !huffman_table_build(lengths, HUFFMAN_ALPHABET_MAX, &table))
+		return (HUFFMAN_ERROR);
+	*size = huffman_table_save(&table, saved);
+	bytes = huffman_table_encode(&table, msg, COUNT, coded, COUNT * 4);
+	huffman_table_free(&table);
+	return (bytes);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	static uint16_t msg[COUNT], back[COUNT];
+	static uint8_t saved[HUFFMAN_TABLE_SAVE_MAX], coded[COUNT * 4];
+	static huffman_table_t table;
+	unsigned int seed = 42;
+	size_t size, bytes, i;
+	int ok;
+
+	/* quantized deltas: small magnitudes are the most frequent */
+	for (i = 0; i < COUNT; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		msg[i] = (uint16_t)((seed >> 16) % 64 * ((seed >> 8) % 64) %
+				    HUFFMAN_ALPHABET_MAX);
+	}
+	msg[0] = HUFFMAN_ALPHABET_MAX - 1;
+	bytes = encoder(msg, saved, &size, coded);
+	if (bytes == HUFFMAN_ERROR || !size)
+		return (EXIT_FAILURE);
+
+	/* the receiving process only has the saved table and the bits */
+	if (huffman_table_load(saved, size, &table) != size ||
+	    huffman_table_decode(&table, coded, bytes, back, COUNT) != COUNT)
+	{
+		huffman_table_free(&table);
+		return (EXIT_FAILURE);
+	}
+	printf("%d symbols: table %lu bytes, %lu bytes coded, %s\n", COUNT,
+	       size, bytes, memcmp(msg, back, sizeof(msg)) ? "mismatch" :
+	       "decoded");
+	coded[bytes / 2] ^= 0x5a;
+	ok = huffman_table_decode(&table, coded, bytes, back, COUNT) != COUNT ||
+		memcmp(msg, back, sizeof(msg));
+	huffman_table_free(&table);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
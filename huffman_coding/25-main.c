@@ -0,0 +1,81 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "huffman.h"
+
+#define LOG_SIZE	((size_t)8 << 20)
+
+/**
+ * file_write - huffman_write_t appending to a stdio stream
+ *
+ * @ctx: The stream
+ * @buf: The bytes to append
+ * @n: Length of @buf
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int file_write(void *ctx, const uint8_t *buf, size_t n)
+{
+	return (fwrite(buf, 1, n, ctx) == n);
+}
+
+/**
+ * log_read - huffman_read_t producing log lines
+ *
+ * @ctx: Amount of bytes produced so far
+ * @buf: Buffer to fill
+ * @n: Length of @buf
+ *
+ * Return: Amount of bytes produced, 0 once LOG_SIZE bytes were
+ */
+size_t log_read(void *ctx, uint8_t *buf, size_t n)
+{
+	size_t *pos = ctx, i;
+
+	for (i = 0; i < n && *pos < LOG_SIZE; i++, (*pos)++)
+		buf[i] = (uint8_t)("GET /index.html 200\n"[*pos % 20] ^
+				   (*pos % 20 == 5 ? *pos / 20 % 8 : 0));
+	return (i);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	huffman_params_t params = {0, 4096, 0, NULL, 0, 4};
+	static uint8_t log[LOG_SIZE];
+	uint8_t slice[100];
+	size_t pos = 0, i, got;
+	uint64_t off;
+	FILE *f = tmpfile();
+
+	if (!f || !huffman_compress_stream(log_read, &pos, file_write, f,
+					   &params) || fflush(f))
+		return (EXIT_FAILURE);
+	pos = 0;
+	log_read(&pos, log, LOG_SIZE);
+	printf("%lu bytes compressed to %ld\n", LOG_SIZE, ftell(f));
+	for (i = 0; i < 1000; i++)
+	{
+		off = (uint64_t)rand() % LOG_SIZE;
+		got = huffman_read_range(fileno(f), off, sizeof(slice), slice);
+		if (got == HUFFMAN_ERROR ||
+		    got != (off < LOG_SIZE - sizeof(slice) ? sizeof(slice) :
+			    LOG_SIZE - off) ||
+		    memcmp(slice, log + off, got))
+		{
+			printf("range at %lu failed\n", (unsigned long)off);
+			return (EXIT_FAILURE);
+		}
+	}
+	if (huffman_read_range(fileno(f), LOG_SIZE, 1, slice) != 0)
+		return (EXIT_FAILURE);
+	got = huffman_read_range(fileno(f), LOG_SIZE / 40 * 20, 20, slice);
+	printf("%lu bytes at %lu: %.*s", got, LOG_SIZE / 40 * 20, (int)got,
+	       slice);
+	fclose(f);
+	return (EXIT_SUCCESS);
+}
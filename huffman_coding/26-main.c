@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "heap.h"
+
+#define VERTICES	6
+#define NONE		-1
+
+/**
+ * struct vertex_s - Vertex of a graph, as queued by Dijkstra's algorithm
+ *
+ * @id: Number of the vertex
+ * @dist: Length of the shortest path found so far from the source
+ * @handle: Handle of the vertex in the queue
+ */
+typedef struct vertex_s
+{
+	int id;
+	int dist;
+	heap_handle_t handle;
+} vertex_t;
+
+/**
+ * dist_cmp - Compares the distances of two vertices
+ *
+ * @p1: First pointer
+ * @p2: Second pointer
+ *
+ * Return: Difference between the two distances
+ */
+int dist_cmp(void *p1, void *p2)
+{
+	return (((vertex_t *)p1)->dist - ((vertex_t *)p2)->dist);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	/* edge weights, NONE where there is no edge */
+	int graph[VERTICES][VERTICES] = {
+		{NONE, 7, 9, NONE, NONE, 14},
+		{7, NONE, 10, 15, NONE, NONE},
+		{9, 10, NONE, 11, NONE, 2},
+		{NONE, 15, 11, NONE, 6, NONE},
+		{NONE, NONE, NONE, 6, NONE, 9},
+		{14, NONE, 2, NONE, 9, NONE}};
+	vertex_t v[VERTICES], *u;
+	heap_t *queue = heap_create(dist_cmp);
+	int i, w;
+
+	for (i = 0; queue && i < VERTICES; i++)
+	{
+		v[i].id = i;
+		v[i].dist = i ? 1000000 : 0;
+		v[i].handle = heap_insert_handle(queue, &v[i]);
+		if (v[i].handle == HEAP_NO_HANDLE)
+			break;
+	}
+	if (!queue || i < VERTICES)
+	{
+		heap_delete(queue, NULL);
+		return (EXIT_FAILURE);
+	}
+	printf("Closest vertex: %d\n", ((vertex_t *)heap_peek(queue))->id);
+	/* vertex 4 is cancelled: it leaves the queue from wherever it is */
+	if (heap_remove(queue, v[4].handle) != &v[4])
+	{
+		heap_delete(queue, NULL);
+		return (EXIT_FAILURE);
+	}
+	v[4].handle = HEAP_NO_HANDLE;
+	while ((u = heap_extract(queue)) != NULL)
+	{
+		u->handle = HEAP_NO_HANDLE;
+		printf("Vertex %d: distance %d\n", u->id, u->dist);
+		for (i = 0; i < VERTICES; i++)
+		{
+			w = graph[u->id][i];
+			if (w != NONE && v[i].handle != HEAP_NO_HANDLE &&
+			    u->dist + w < v[i].dist)
+			{
+				v[i].dist = u->dist + w;
+				heap_decrease_key(queue, v[i].handle);
+			}
+		}
+	}
+	heap_delete(queue, NULL);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,57 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "heap.h"
+
+/**
+ * int_cmp - Compares two integers
+ *
+ * @p1: First pointer
+ * @p2: Second pointer
+ *
+ * Return: Difference between the two integers
+ */
+int int_cmp(void *p1, void *p2)
+{
+	int *n1, *n2;
+
+	n1 = (int *)p1;
+	n2 = (int *)p2;
+	return (*n1 - *n2);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	heap_t *heap;
+	int array[100];
+	size_t size = sizeof(array) / sizeof(array[0]);
+	size_t i;
+	int *n;
+
+	heap = heap_create(int_cmp);
+	if (heap == NULL)
+	{
+		fprintf(stderr, "Failed to create the heap\n");
+		return (EXIT_FAILURE);
+	}
+	for (i = 0; i < size; ++i)
+	{
+		array[i] = (int)((i * 37) % size);
+		if (heap_insert(heap, &(array[i])) == NULL)
+		{
+			fprintf(stderr, "Failed to insert a node\n");
+			heap_delete(heap, NULL);
+			return (EXIT_FAILURE);
+		}
+	}
+	printf("Heap size: %lu\n", heap->size);
+	while ((n = heap_extract(heap)) != NULL)
+		printf("%d%s", *n, heap->size ? " " : "\n");
+	printf("Heap size: %lu\n", heap->size);
+	heap_delete(heap, NULL);
+	return (EXIT_SUCCESS);
+}
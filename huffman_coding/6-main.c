@@ -33,7 +33,7 @@ int nested_print(char *buffer, void *data)
 int main(void)
 {
 	heap_t *priority_queue;
-	char data[] = {
+	uint16_t data[] = {
 	    'a', 'b', 'c', 'd', 'e', 'f'};
 	size_t freq[] = {
 	    6, 11, 12, 13, 16, 36};
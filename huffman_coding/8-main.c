@@ -20,9 +20,7 @@ int symbol_print(char *buffer, void *data)
 	int length;
 
 	symbol = (symbol_t *)data;
-	c = symbol->data;
-	if (c == -1)
-		c = '$';
+	c = symbol->internal ? '$' : (char)symbol->data;
 	length = sprintf(buffer, "(%c/%lu)", c, symbol->freq);
 	return (length);
 }
@@ -35,7 +33,7 @@ int symbol_print(char *buffer, void *data)
 int main(void)
 {
 	binary_tree_node_t *root;
-	char data[] = {
+	uint16_t data[] = {
 		'a', 'b', 'c', 'd', 'e', 'f'
 	};
 	size_t freq[] = {
@@ -24,25 +24,64 @@ typedef binary_tree_node_t node_t;
 /**
  * struct heap_s - Heap data structure
  *
+ * The nodes live in one growable array, in level order: the children of
+ * nodes[i] are nodes[2i + 1] and nodes[2i + 2]. Their left, right and parent
+ * pointers are kept in sync with that layout, so the heap can still be
+ * walked as a tree from @root.
+ *
+ * Data moves between nodes as the heap is restored, so each item also has
+ * a handle that follows it: @ids and @slots are inverse permutations of
+ * the @capacity handles, the first @size entries of @ids being the handles
+ * of the items in the heap, and the others the handles free for reuse.
+ *
  * @size: Number of nodes in the heap
  * @data_cmp: Function to compare two node data
- * @root: Pointer to the root node
+ * @root: Pointer to the root node, &nodes[0] or NULL if the heap is empty
+ * @nodes: Array of nodes, in level order
+ * @capacity: Allocated length of @nodes, @ids and @slots
+ * @ids: Handle of the item in each node
+ * @slots: Index in @nodes of the item of each handle
  */
 typedef struct heap_s
 {
 	size_t size;
 	int (*data_cmp)(void *, void *);
 	binary_tree_node_t *root;
+	binary_tree_node_t *nodes;
+	size_t capacity;
+	size_t *ids;
+	size_t *slots;
 } heap_t;
 
+/**
+ * heap_handle_t - Handle of an item of a heap, valid from its insertion
+ * until it leaves the heap, wherever the item moves meanwhile
+ */
+typedef size_t heap_handle_t;
+
+#define HEAP_NO_HANDLE	((heap_handle_t)-1)
+
 /* Heap core API */
 heap_t *heap_create(int (*data_cmp)(void *, void *));
+heap_t *heap_build(int (*data_cmp)(void *, void *), void **items, size_t n);
 binary_tree_node_t *binary_tree_node(binary_tree_node_t *parent, void *data);
 binary_tree_node_t *heap_insert(heap_t *heap, void *data);
 void *heap_extract(heap_t *heap);
+heap_handle_t heap_insert_handle(heap_t *heap, void *data);
+int heap_decrease_key(heap_t *heap, heap_handle_t handle);
+void *heap_remove(heap_t *heap, heap_handle_t handle);
+void *heap_peek(const heap_t *heap);
 void heap_delete(heap_t *heap, void (*free_data)(void *));
 void free_binary_tree_node(node_t *node, void (*free_data)(void *));
 
+/* Heap array helpers */
+void heap_relink(heap_t *heap);
+int heap_reserve(heap_t *heap, size_t capacity);
+void heap_swap(heap_t *heap, size_t i, size_t j);
+void heap_sift_up(heap_t *heap, size_t i);
+void heapify(heap_t *heap, size_t i);
+void *heap_take(heap_t *heap, size_t i);
+
 /* Debug / display helpers */
 void binary_tree_print(const binary_tree_node_t *root,
 		       int (*print_data)(char *, void *));
@@ -0,0 +1,47 @@
+#include "heap.h"
+#include <stdlib.h>
+
+/**
+ * heap_build - creates a heap from a batch of items in O(n), by filling the
+ * node array directly and sifting down every parent node from the last one
+ * up to the root (Floyd's algorithm)
+ * @data_cmp: pointer to a comparison function
+ * @items: array of data pointers, none of them NULL; the array itself is
+ * not kept by the heap
+ * @n: length of @items
+ * Return: pointer to the created heap_t structure, or NULL on failure
+ */
+heap_t *heap_build(int (*data_cmp)(void *, void *), void **items, size_t n)
+{
+	heap_t *h;
+	size_t i;
+
+	if (!data_cmp || (n && !items))
+		return (NULL);
+
+	h = heap_create(data_cmp);
+	if (h == NULL)
+		return (NULL);
+
+	if (!heap_reserve(h, n < 16 ? 16 : n))
+	{
+		heap_delete(h, NULL);
+		return (NULL);
+	}
+	for (i = 0; i < n; i++)
+	{
+		if (items[i] == NULL)
+		{
+			heap_delete(h, NULL);
+			return (NULL);
+		}
+		h->nodes[i].data = items[i];
+		h->size++;
+	}
+	heap_relink(h);
+
+	for (i = n / 2; i > 0; i--)
+		heapify(h, i - 1);
+
+	return (h);
+}
@@ -24,9 +24,15 @@ void free_binary_tree_node(node_t *node, void (*free_data)(void *))
  */
 void heap_delete(heap_t *heap, void (*free_data)(void *))
 {
+	size_t i;
+
 	if (heap)
 	{
-		free_binary_tree_node(heap->root, free_data);
+		for (i = 0; free_data && i < heap->size; i++)
+			free_data(heap->nodes[i].data);
+		free(heap->nodes);
+		free(heap->ids);
+		free(heap->slots);
 		free(heap);
 	}
 }
\ No newline at end of file
@@ -2,82 +2,71 @@
 #include <stdlib.h>
 
 /**
- * heapify - restores heap property from root downwards
- * @root: node_t root of heap subtree
- * @data_cmp: comparison function for node data
+ * heapify - restores heap property from a node downwards
+ * @heap: heap_t pointer
+ * @i: index of the node in the heap array
  */
-static void heapify(node_t *root, int (*data_cmp)(void *, void *))
+void heapify(heap_t *heap, size_t i)
 {
-	if (!root || !root->left || !data_cmp)
-		return;
+	node_t *a = heap->nodes;
+	size_t child;
 
-	if (root->right && data_cmp(root->left->data, root->right->data) > 0)
+	while ((child = 2 * i + 1) < heap->size)
 	{
-		if (data_cmp(root->data, root->right->data) >= 0)
-			DATASWAP(root, root->right);
-		heapify(root->right, data_cmp);
-	}
-	else
-	{
-		if (data_cmp(root->data, root->left->data) >= 0)
-			DATASWAP(root, root->left);
-		heapify(root->left, data_cmp);
+		if (child + 1 < heap->size &&
+		    heap->data_cmp(a[child + 1].data, a[child].data) < 0)
+			child++;
+		if (heap->data_cmp(a[child].data, a[i].data) >= 0)
+			break;
+		heap_swap(heap, i, child);
+		i = child;
 	}
 }
 
 /**
- * heap_to_array - converts heap tree to array while calculating size
- * @array: buffer to store heap nodes
- * @root: root node of heap subtree
- * @i: index in array
- * Return: size_t size of heap
- */
-static size_t heap_to_array(node_t **array, node_t *root, size_t i)
-{
-	if (!root || !array)
-		return (0);
-
-	array[i] = root;
-
-	return (1 + heap_to_array(array, root->left, 2 * i + 1)
-			+ heap_to_array(array, root->right, 2 * i + 2));
-}
-
-/**
- * heap_extract - extracts the root value of a Min Binary Heap
+ * heap_take - removes the item of any node, in O(log n): the last node's
+ * item takes its place, then moves up or down to where it belongs
  * @heap: heap_t pointer
- * Return: pointer to data stored in heap's root or NULL
+ * @i: index of the node in the heap array, below @heap->size
+ * Return: pointer to the data removed
  */
-void *heap_extract(heap_t *heap)
+void *heap_take(heap_t *heap, size_t i)
 {
-	node_t *a[32], *last;
-	void *data;
-
-	if (!heap || !heap->root)
-		return (NULL);
-
-	if (heap->size != heap_to_array(a, heap->root, 0))
-		return (NULL);
+	node_t *last;
+	void *data = heap->nodes[i].data;
 
-	data = heap->root->data;
-	last = a[heap->size - 1];
+	last = &heap->nodes[heap->size - 1];
+	heap_swap(heap, i, heap->size - 1);
+	heap->size--;
 
 	if (heap->root == last)
 		heap->root = NULL;
 	else
 	{
-		heap->root->data = last->data;
-
 		if (last->parent->left == last)
 			last->parent->left = NULL;
 		else
 			last->parent->right = NULL;
 
-		heapify(heap->root, heap->data_cmp);
+		if (i < heap->size)
+		{
+			heap_sift_up(heap, i);
+			heapify(heap, i);
+		}
 	}
 
-	free(last);
-	heap->size--;
-
 	return (data);
-}
\ No newline at end of file
+}
+
+/**
+ * heap_extract - extracts the root value of a Min Binary Heap, in O(log n)
+ * @heap: heap_t pointer
+ * Return: pointer to data stored in heap's root or NULL
+ */
+void *heap_extract(heap_t *heap)
+{
+	if (!heap || !heap->root)
+		return (NULL);
+
+	return (heap_take(heap, 0));
+}
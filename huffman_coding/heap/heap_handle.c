@@ -0,0 +1,72 @@
+#include "heap.h"
+
+/**
+ * handle_slot - finds the node of a handle
+ * @heap: heap_t pointer
+ * @handle: handle returned by heap_insert_handle()
+ * Return: index of the node in the heap array, or @heap->size if @handle
+ * is not the handle of an item in the heap
+ */
+static size_t handle_slot(const heap_t *heap, heap_handle_t handle)
+{
+	if (handle >= heap->capacity || heap->slots[handle] >= heap->size)
+		return (heap->size);
+	return (heap->slots[handle]);
+}
+
+/**
+ * heap_decrease_key - moves an item up the heap after its key was lowered,
+ * in O(log n); the caller changes the key within the item's data, then
+ * calls this before any other heap operation
+ * @heap: heap_t pointer
+ * @handle: handle of the item
+ * Return: 1 on success, 0 if @handle is not in the heap
+ */
+int heap_decrease_key(heap_t *heap, heap_handle_t handle)
+{
+	size_t i;
+
+	if (!heap)
+		return (0);
+	i = handle_slot(heap, handle);
+	if (i == heap->size)
+		return (0);
+
+	heap_sift_up(heap, i);
+
+	return (1);
+}
+
+/**
+ * heap_remove - removes any item from the heap, in O(log n)
+ * @heap: heap_t pointer
+ * @handle: handle of the item, which may be reused by later insertions
+ * Return: pointer to the data removed, or NULL if @handle is not in the
+ * heap
+ */
+void *heap_remove(heap_t *heap, heap_handle_t handle)
+{
+	size_t i;
+
+	if (!heap)
+		return (NULL);
+	i = handle_slot(heap, handle);
+	if (i == heap->size)
+		return (NULL);
+
+	return (heap_take(heap, i));
+}
+
+/**
+ * heap_peek - reads the root value of a Min Binary Heap without removing
+ * it, in O(1)
+ * @heap: heap_t pointer
+ * Return: pointer to data stored in heap's root or NULL
+ */
+void *heap_peek(const heap_t *heap)
+{
+	if (!heap || !heap->root)
+		return (NULL);
+
+	return (heap->root->data);
+}
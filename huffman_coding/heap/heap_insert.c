@@ -1,57 +1,137 @@
 #include "heap.h"
+#include <stdlib.h>
 
 /**
- * heapify - restores heap property from leaf node of subtree
- * @node: node_t leaf node of heap tree
- * @data_cmp: comparison function over generic data pointers
- * Return: node_t pointer to sifted up node
+ * heap_relink - points every node of the heap array at its parent and
+ * children again, after the array has moved or been filled in bulk
+ * @heap: heap_t pointer
  */
-static node_t *heapify(node_t *node, int (*data_cmp)(void *, void *))
+void heap_relink(heap_t *heap)
 {
-	if (!node || !data_cmp)
-		return (NULL);
+	node_t *a = heap->nodes;
+	size_t i;
 
-	while (node->parent && data_cmp(node->data, node->parent->data) < 0)
+	for (i = 0; i < heap->size; i++)
 	{
-		DATASWAP(node, node->parent);
-		node = node->parent;
+		a[i].parent = i ? &a[(i - 1) / 2] : NULL;
+		a[i].left = 2 * i + 1 < heap->size ? &a[2 * i + 1] : NULL;
+		a[i].right = 2 * i + 2 < heap->size ? &a[2 * i + 2] : NULL;
 	}
+	heap->root = heap->size ? a : NULL;
+}
 
-	return (node);
+/**
+ * heap_reserve - grows the heap array and the handle arrays to a given
+ * capacity, the new handles joining the free ones
+ * @heap: heap_t pointer
+ * @capacity: new capacity, larger than the current one
+ * Return: 1 on success, 0 on failure
+ */
+int heap_reserve(heap_t *heap, size_t capacity)
+{
+	node_t *nodes;
+	size_t *ids, *slots, i;
+
+	nodes = realloc(heap->nodes, sizeof(node_t) * capacity);
+	if (!nodes)
+		return (0);
+	heap->nodes = nodes;
+	heap_relink(heap);
+	ids = realloc(heap->ids, sizeof(size_t) * capacity);
+	if (!ids)
+		return (0);
+	heap->ids = ids;
+	slots = realloc(heap->slots, sizeof(size_t) * capacity);
+	if (!slots)
+		return (0);
+	heap->slots = slots;
+
+	for (i = heap->capacity; i < capacity; i++)
+		ids[i] = slots[i] = i;
+	heap->capacity = capacity;
+
+	return (1);
 }
 
 /**
- * heap_insert - inserts a value in a binary heap
- *                  (uses static reference array)
- * @heap: pointer to heap_t where we'll insert node
- * @data: generic pointer to data for new node
- * Return: node_t pointer to the newly inserted node
+ * heap_swap - exchanges the items of two nodes, their handles following
+ * @heap: heap_t pointer
+ * @i: index of the first node
+ * @j: index of the second node
  */
-node_t *heap_insert(heap_t *heap, void *data)
+void heap_swap(heap_t *heap, size_t i, size_t j)
 {
-	static node_t *harray[32];
-	node_t *new, *parent;
+	DATASWAP(&heap->nodes[i], &heap->nodes[j]);
+	SWAP(heap->ids[i], heap->ids[j]);
+	heap->slots[heap->ids[i]] = i;
+	heap->slots[heap->ids[j]] = j;
+}
 
-	if (!heap || !data)
-		return (NULL);
+/**
+ * heap_sift_up - restores heap property from a node upwards
+ * @heap: heap_t pointer
+ * @i: index of the node in the heap array
+ */
+void heap_sift_up(heap_t *heap, size_t i)
+{
+	node_t *a = heap->nodes;
 
-	if (heap->size == 0)
+	while (i && heap->data_cmp(a[i].data, a[(i - 1) / 2].data) < 0)
 	{
-		harray[heap->size++] = binary_tree_node(NULL, data);
-		heap->root = harray[0];
-		return (heap->root);
+		heap_swap(heap, i, (i - 1) / 2);
+		i = (i - 1) / 2;
 	}
+}
 
-	/* find parent of new node */
-	parent = harray[(heap->size - 1) / 2];
+/**
+ * heap_insert_handle - inserts a value in a binary heap, in O(log n)
+ * @heap: pointer to heap_t where we'll insert node
+ * @data: generic pointer to data for new node
+ * Return: handle of @data, or HEAP_NO_HANDLE on failure
+ */
+heap_handle_t heap_insert_handle(heap_t *heap, void *data)
+{
+	heap_handle_t handle;
+	node_t *node;
+	size_t i;
 
-	/* insert left or right */
-	harray[heap->size++] = (!parent->left)
-		? (parent->left = binary_tree_node(parent, data))
-		: (parent->right = binary_tree_node(parent, data));
+	if (!heap || !data || !heap->data_cmp)
+		return (HEAP_NO_HANDLE);
+	if (heap->size == heap->capacity &&
+	    !heap_reserve(heap, heap->capacity ? heap->capacity * 2 : 16))
+		return (HEAP_NO_HANDLE);
 
-	/* restore heap property */
-	new = heapify(harray[heap->size - 1], heap->data_cmp);
+	/* the free handle after the last item becomes the new item's */
+	i = heap->size++;
+	node = &heap->nodes[i];
+	node->data = data;
+	node->left = NULL;
+	node->right = NULL;
+	node->parent = i ? &heap->nodes[(i - 1) / 2] : NULL;
+	if (i % 2)
+		node->parent->left = node;
+	else if (i)
+		node->parent->right = node;
+	heap->root = heap->nodes;
+	handle = heap->ids[i];
 
-	return (new);
-}
\ No newline at end of file
+	heap_sift_up(heap, i);
+
+	return (handle);
+}
+
+/**
+ * heap_insert - inserts a value in a binary heap, in O(log n)
+ * @heap: pointer to heap_t where we'll insert node
+ * @data: generic pointer to data for new node
+ * Return: node_t pointer to the node now holding @data, or NULL on failure;
+ * it is only valid until the heap is next modified
+ */
+node_t *heap_insert(heap_t *heap, void *data)
+{
+	heap_handle_t handle = heap_insert_handle(heap, data);
+
+	if (handle == HEAP_NO_HANDLE)
+		return (NULL);
+	return (&heap->nodes[heap->slots[handle]]);
+}
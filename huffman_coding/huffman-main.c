@@ -0,0 +1,400 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include "huffman.h"
+
+#define BENCH_RUNS	3
+
+/**
+ * struct options_s - Command line of the huffman tool
+ *
+ * @mode: 'c' to compress, 'd' to decompress, 'b' to benchmark
+ * @params: Stream options
+ * @verbose: If set, the work of each thread is printed
+ * @runs: Amount of runs of each direction the benchmark keeps the best of
+ * @input: Input file, "-" for stdin
+ * @output: Output file, "-" for stdout
+ */
+typedef struct options_s
+{
+	int mode;
+	huffman_params_t params;
+	int verbose;
+	size_t runs;
+	const char *input;
+	const char *output;
+} options_t;
+
+/**
+ * struct buffer_s - Memory used as input or output of the stream functions
+ *
+ * @data: The bytes
+ * @size: Amount of bytes used
+ * @cap: Amount of bytes allocated
+ */
+typedef struct buffer_s
+{
+	uint8_t *data;
+	size_t size;
+	size_t cap;
+} buffer_t;
+
+/**
+ * usage - prints how to run the tool
+ *
+ * @name: Name the tool was run as
+ *
+ * Return: EXIT_FAILURE
+ */
+int usage(const char *name)
+{
+	fprintf(stderr,
+		"Usage: %s -c|-d [options] input output\n"
+		"       %s --bench [options] input\n"
+		"  -b size     block size, k and m suffixes allowed\n"
+		"  -t threads  threads coding blocks\n"
+		"  -i blocks   write a seek index, an entry every so many "
+		"blocks\n"
+		"  -r runs     benchmark runs, the best one is reported\n"
+		"  -v          print the work of each thread\n"
+		"  -           as input or output: stdin or stdout\n",
+		name, name);
+	return (EXIT_FAILURE);
+}
+
+/**
+ * parse_size - reads a number, with an optional k or m suffix
+ *
+ * @s: The text
+ * @v: Receives the number
+ *
+ * Return: 1 on success, 0 if @s is not a number or does not fit a size_t
+ */
+int parse_size(const char *s, size_t *v)
+{
+	unsigned int shift = 0;
+	char *end;
+
+	if (!s || *s < '0' || *s > '9')
+		return (0);
+	errno = 0;
+	*v = strtoul(s, &end, 10);
+	if (*end == 'k' || *end == 'K')
+		shift = 10;
+	else if (*end == 'm' || *end == 'M')
+		shift = 20;
+	if (shift)
+		end++;
+	if (errno || *end || *v > (SIZE_MAX >> shift))
+		return (0);
+	*v <<= shift;
+	return (1);
+}
+
+/**
+ * parse_args - reads the command line
+ *
+ * @ac: Arguments count
+ * @av: Arguments vector
+ * @opt: Receives the options
+ *
+ * Return: 1 on success, 0 if the command line is invalid
+ */
+int parse_args(int ac, char **av, options_t *opt)
+{
+	size_t v;
+	int i;
+
+	for (i = 1; i < ac; i++)
+	{
+		if (!strcmp(av[i], "-c") || !strcmp(av[i], "-d"))
+			opt->mode = av[i][1];
+		else if (!strcmp(av[i], "--bench"))
+			opt->mode = 'b';
+		else if (!strcmp(av[i], "-v"))
+			opt->verbose = 1;
+		else if (av[i][0] == '-' && av[i][1] &&
+			 strchr("btir", av[i][1]) && !av[i][2])
+		{
+			if (++i == ac || !parse_size(av[i], &v) ||
+			    (strchr("ti", av[i - 1][1]) && v > UINT_MAX))
+				return (0);
+			if (av[i - 1][1] == 'b')
+				opt->params.block_size = v;
+			else if (av[i - 1][1] == 't')
+				opt->params.threads = (unsigned int)v;
+			else if (av[i - 1][1] == 'i')
+				opt->params.index_interval = (unsigned int)v;
+			else
+				opt->runs = v;
+		}
+		else if (av[i][0] == '-' && av[i][1])
+			return (0);
+		else if (!opt->input)
+			opt->input = av[i];
+		else if (!opt->output)
+			opt->output = av[i];
+		else
+			return (0);
+	}
+	return (opt->mode && opt->input && opt->runs &&
+		(opt->mode == 'b') == !opt->output &&
+		opt->params.threads <= HUFFMAN_THREADS_MAX &&
+		huffman_block_size(&opt->params));
+}
+
+/**
+ * open_file - opens a file named on the command line
+ *
+ * @name: The name, "-" for stdin or stdout
+ * @out: If set, the file is opened for writing
+ *
+ * Return: File descriptor, or -1 on failure
+ */
+int open_file(const char *name, int out)
+{
+	int fd;
+
+	if (!strcmp(name, "-"))
+		return (out ? STDOUT_FILENO : STDIN_FILENO);
+	if (out)
+		fd = open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	else
+		fd = open(name, O_RDONLY);
+	if (fd < 0)
+		perror(name);
+	return (fd);
+}
+
+/**
+ * run_file - compresses or decompresses a file into another
+ *
+ * @opt: The options
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int run_file(options_t *opt)
+{
+	int in = open_file(opt->input, 0), out = -1, ok = 0;
+
+	if (in >= 0)
+		out = open_file(opt->output, 1);
+	if (in >= 0 && out >= 0)
+	{
+		if (opt->mode == 'c')
+			ok = huffman_compress_fd(in, out, &opt->params);
+		else
+			ok = huffman_decompress_fd(in, out, &opt->params);
+		if (!ok)
+			fprintf(stderr, "Failed to %s %s\n", opt->mode == 'c' ?
+				"compress" : "decompress", opt->input);
+		else if (opt->verbose)
+			huffman_stats_print(opt->params.stats,
+					    opt->params.threads);
+	}
+	if (in > STDERR_FILENO)
+		close(in);
+	if (out > STDERR_FILENO && close(out))
+		ok = 0;
+	return (ok);
+}
+
+/**
+ * buffer_read - huffman_read_t reading from a buffer
+ *
+ * @ctx: The buffer
+ * @buf: Where to copy the bytes
+ * @n: Length of @buf
+ *
+ * Return: Amount of bytes copied
+ */
+size_t buffer_read(void *ctx, uint8_t *buf, size_t n)
+{
+	buffer_t *b = ctx;
+
+	if (n > b->cap - b->size)
+		n = b->cap - b->size;
+	memcpy(buf, b->data + b->size, n);
+	b->size += n;
+	return (n);
+}
+
+/**
+ * buffer_write - huffman_write_t appending to a buffer
+ *
+ * @ctx: The buffer
+ * @buf: The bytes to append
+ * @n: Length of @buf
+ *
+ * Return: 1 on success, 0 if the buffer is full
+ */
+int buffer_write(void *ctx, const uint8_t *buf, size_t n)
+{
+	buffer_t *b = ctx;
+
+	if (n > b->cap - b->size)
+		return (0);
+	memcpy(b->data + b->size, buf, n);
+	b->size += n;
+	return (1);
+}
+
+/**
+ * read_all - reads a whole file into memory
+ *
+ * @fd: File descriptor to read
+ * @b: Receives the bytes
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int read_all(int fd, buffer_t *b)
+{
+	uint8_t *grown;
+	ssize_t got = 1;
+
+	while (got > 0 || (got < 0 && errno == EINTR))
+	{
+		if (b->size == b->cap)
+		{
+			b->cap = b->cap ? b->cap * 2 : (size_t)1 << 20;
+			grown = realloc(b->data, b->cap);
+			if (!grown)
+				return (0);
+			b->data = grown;
+		}
+		got = read(fd, b->data + b->size, b->cap - b->size);
+		if (got > 0)
+			b->size += (size_t)got;
+	}
+	return (got == 0);
+}
+
+/**
+ * seconds - reads a monotonic clock
+ *
+ * Return: Time in seconds
+ */
+double seconds(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+/**
+ * bench_run - compresses a buffer and decompresses it back, timing both
+ *
+ * @opt: The options
+ * @data: The bytes to compress
+ * @packed: Receives the compressed stream
+ * @back: Receives the decompressed bytes
+ * @t: Receives the time each direction took
+ *
+ * Return: 1 if the bytes came back identical, 0 on failure
+ */
+int bench_run(options_t *opt, buffer_t *data, buffer_t *packed,
+	      buffer_t *back, double *t)
+{
+	double start = seconds();
+
+	data->size = packed->size = back->size = 0;
+	if (!huffman_compress_stream(buffer_read, data, buffer_write, packed,
+				     &opt->params))
+		return (0);
+	t[0] = seconds() - start;
+	if (opt->verbose)
+		huffman_stats_print(opt->params.stats, opt->params.threads);
+	packed->cap = packed->size;
+	packed->size = 0;
+	start = seconds();
+	if (!huffman_decompress_stream(buffer_read, packed, buffer_write, back,
+				       &opt->params))
+		return (0);
+	t[1] = seconds() - start;
+	if (opt->verbose)
+		huffman_stats_print(opt->params.stats, opt->params.threads);
+	packed->size = packed->cap;
+	return (back->size == data->cap &&
+		!memcmp(back->data, data->data, data->cap));
+}
+
+/**
+ * bench - reports the compression ratio of a file, and the throughput of
+ * compression and decompression in memory, the best of a few runs
+ *
+ * @opt: The options
+ *
+ * Return: 1 on success, 0 on failure
+ */
+int bench(options_t *opt)
+{
+	buffer_t data = {NULL, 0, 0}, packed = {NULL, 0, 0}, back;
+	size_t block = huffman_block_size(&opt->params), blocks, i;
+	double best[2] = {0, 0}, t[2];
+	int in = open_file(opt->input, 0), ok = in >= 0;
+
+	ok = ok && read_all(in, &data);
+	if (in > STDERR_FILENO)
+		close(in);
+	data.cap = data.size;
+	blocks = data.size / block + 1;
+	back.cap = data.size;
+	back.data = malloc(back.cap + 1);
+	for (i = 0; ok && i < opt->runs; i++)
+	{
+		packed.cap = HUFFMAN_STREAM_HEADER + HUFFMAN_FRAME_HEADER +
+			blocks * (huffman_frame_bound(block) +
+				  HUFFMAN_INDEX_ENTRY) + HUFFMAN_INDEX_FOOTER;
+		if (!packed.data)
+			packed.data = malloc(packed.cap);
+		ok = back.data && packed.data &&
+			bench_run(opt, &data, &packed, &back, t);
+		best[0] = !i || t[0] < best[0] ? t[0] : best[0];
+		best[1] = !i || t[1] < best[1] ? t[1] : best[1];
+	}
+	if (ok)
+		printf("%s: %lu -> %lu bytes, ratio %.3f\n"
+		       "compress:   %.1f MB/s\ndecompress: %.1f MB/s\n",
+		       opt->input, data.cap, packed.size, packed.size ?
+		       (double)data.cap / packed.size : 0.0,
+		       data.cap / 1e6 / best[0], data.cap / 1e6 / best[1]);
+	else
+		fprintf(stderr, "Failed to benchmark %s\n", opt->input);
+	free(data.data);
+	free(packed.data);
+	free(back.data);
+	return (ok);
+}
+
+/**
+ * main - Entry point
+ *
+ * @ac: Arguments count
+ * @av: Arguments vector
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(int ac, char **av)
+{
+	options_t opt = {0, {0, 0, 0, NULL, 0, 0}, 0, BENCH_RUNS, NULL,
+			 NULL};
+	huffman_thread_stats_t stats[HUFFMAN_THREADS_MAX];
+	int ok;
+
+	if (!parse_args(ac, av, &opt))
+		return (usage(av[0]));
+	if (opt.verbose)
+	{
+		opt.params.threads = opt.params.threads ? opt.params.threads
+			: 1;
+		opt.params.stats = stats;
+	}
+	ok = opt.mode == 'b' ? bench(&opt) : run_file(&opt);
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
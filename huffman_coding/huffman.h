@@ -2,6 +2,7 @@
 #define HUFFMAN_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "heap.h"
 
@@ -9,24 +10,415 @@
 #define BLUE	"\033[0;34m"
 #define NC	"\033[0m"
 
+/* largest alphabet the tree and symbol coders take */
+#define HUFFMAN_ALPHABET_MAX	4096
+#define HUFFMAN_FLAT_NODES	(2 * HUFFMAN_ALPHABET_MAX - 1)
+#define HUFFMAN_FLAT_NONE	0xffff
+
 /**
- * struct symbol_s - Stores a char and its associated frequency
+ * struct symbol_s - Stores a symbol and its associated frequency
  *
- * @data: The character
+ * @data: The symbol: a byte, a token, a quantized value..., below
+ * HUFFMAN_ALPHABET_MAX; every value, 0 included, is a valid symbol
+ * @internal: Set for the merged nodes of a Huffman tree, which stand for
+ * no symbol, @data being 0
  * @freq: The associated frequency
  */
 typedef struct symbol_s
 {
-	char data;
+	uint16_t data;
+	unsigned char internal;
 	size_t freq;
 } symbol_t;
 
-symbol_t *symbol_create(char data, size_t freq);
-heap_t *huffman_priority_queue(char *data, size_t *freq, size_t size);
+/*
+ * Block format written by huffman_encode():
+ * [0]      mode, HUFFMAN_MODE_RAW, HUFFMAN_MODE_HUFF or HUFFMAN_MODE_HUFF4
+ * [1..8]   decoded length, 64-bit little-endian
+ * raw:     the bytes themselves
+ * huff:    code lengths packed by huffman_lengths_write(), then the bit
+ *          stream of the canonical codes they describe, least significant
+ *          bit first, zero-padded to a whole byte
+ * huff4:   code lengths as for huff, then the byte lengths of the first
+ *          three of HUFFMAN_STREAMS bit streams (32-bit little-endian
+ *          each), then the streams, each coded as for huff; stream i holds
+ *          the symbols from i * q on, q being the decoded length divided by
+ *          HUFFMAN_STREAMS rounded up, and the last one the rest
+ */
+#define HUFFMAN_MODE_RAW	0
+#define HUFFMAN_MODE_HUFF	1
+#define HUFFMAN_MODE_HUFF4	2
+#define HUFFMAN_STREAMS		4
+#define HUFFMAN_JUMP_TABLE	(4 * (HUFFMAN_STREAMS - 1))
+/* blocks whose estimated coded size does not save 1 / HUFFMAN_MIN_GAIN */
+/* of their size are stored raw without building a code */
+#define HUFFMAN_MIN_GAIN	32
+/* smallest block huffman_encode() splits into HUFFMAN_STREAMS streams */
+#define HUFFMAN_STREAMS_MIN	1024
+#define HUFFMAN_HEADER		9
+#define HUFFMAN_SYMBOLS		256
+#define HUFFMAN_MAX_BITS	32
+#define HUFFMAN_ERROR		((size_t)-1)
+/*
+ * Stream format written by huffman_compress_stream():
+ * header:  HUFFMAN_MAGIC, HUFFMAN_VERSION, then the block size (32-bit
+ *          little-endian), the most any block decodes to
+ * frames:  for each block, its encoded length (32-bit little-endian) then
+ *          the block as written by huffman_encode_params()
+ * end:     an encoded length of 0
+ * index:   only if params->index_interval is set, for every
+ *          index_interval-th block the stream offset of its frame and the
+ *          offset of its first byte in the decoded data (64-bit each), then
+ *          a footer: the decoded size (64-bit), index_interval and the
+ *          amount of entries (32-bit each), and HUFFMAN_INDEX_MAGIC; all
+ *          little-endian. Decoders stop at the end marker and never see it
+ */
+#define HUFFMAN_MAGIC		"HUFF"
+#define HUFFMAN_VERSION		1
+#define HUFFMAN_STREAM_HEADER	9
+#define HUFFMAN_FRAME_HEADER	4
+#define HUFFMAN_BLOCK_DEFAULT	((size_t)128 << 10)
+#define HUFFMAN_BLOCK_MAX	((size_t)64 << 20)
+#define HUFFMAN_THREADS_MAX	64
+#define HUFFMAN_INDEX_MAGIC	"HIDX"
+#define HUFFMAN_INDEX_ENTRY	16
+#define HUFFMAN_INDEX_FOOTER	20
+
+/* code length limit huffman_encode() uses: every code decodes in one */
+/* primary table lookup */
+#define HUFFMAN_DEFAULT_MAX_BITS	11
+/* largest code length header: the last symbol, then 3 nibbles a symbol */
+#define HUFFMAN_LENGTHS_BOUND(size) \
+	(((size) > HUFFMAN_SYMBOLS ? 2 : 1) + ((size) * 3 + 1) / 2)
+#define HUFFMAN_LENGTHS_MAX	HUFFMAN_LENGTHS_BOUND(HUFFMAN_SYMBOLS)
+
+/*
+ * Shared code tables, trained once by huffman_dict_train() and used for
+ * many small messages. Saved form: HUFFMAN_DICT_MAGIC, the code length of
+ * the escape symbol (0 if there is none), then the code lengths of the
+ * bytes packed by huffman_lengths_write(). Each message is its length n as
+ * a little-endian base-128 varint of (n << 1 | raw), then the n bytes if
+ * raw, or else the bit stream of their codes, a byte missing from the
+ * table being coded as the escape symbol followed by the byte on 8 bits
+ */
+#define HUFFMAN_DICT_MAGIC	"HUFT"
+#define HUFFMAN_DICT_ESCAPE	HUFFMAN_SYMBOLS
+#define HUFFMAN_DICT_BITS	11
+#define HUFFMAN_DICT_SAVE_MAX	(5 + HUFFMAN_LENGTHS_MAX)
+
+/*
+ * Two-level decoding tables: codes of up to HUFFMAN_LOOKUP_BITS bits
+ * resolve in the primary table, longer ones through a secondary table
+ * linked from it; tables of up to HUFFMAN_LOOKUP_STACK entries live in a
+ * buffer of the caller, larger ones are allocated
+ */
+#define HUFFMAN_LOOKUP_BITS	11
+#define HUFFMAN_LOOKUP_STACK	4096
+
+/*
+ * Code tables of symbols below HUFFMAN_ALPHABET_MAX, for an encoder and a
+ * decoder that do not share memory. Saved form: HUFFMAN_TABLE_MAGIC, then
+ * the code lengths packed by huffman_lengths_write() for an alphabet of
+ * HUFFMAN_ALPHABET_MAX symbols; the codes are the canonical ones. Symbols
+ * are coded as a bare bit stream, least significant bit first
+ */
+#define HUFFMAN_TABLE_MAGIC	"HUFC"
+#define HUFFMAN_TABLE_SAVE_MAX \
+	(4 + HUFFMAN_LENGTHS_BOUND(HUFFMAN_ALPHABET_MAX))
+
+/**
+ * struct huffman_code_s - Code of one symbol, ready for the bit writer
+ *
+ * @bits: The code, bit-reversed so that its first bit is the least
+ * significant one
+ * @length: Amount of bits in the code, 0 if the symbol is not coded
+ */
+typedef struct huffman_code_s
+{
+	uint32_t bits;
+	unsigned char length;
+} huffman_code_t;
+
+/**
+ * struct huffman_entry_s - Decoding table entry
+ *
+ * @value: Symbol, or for a link to a secondary table, its offset
+ * @length: Length of the code, 0 for codes that do not exist
+ * @sub: 0 for a symbol, or the amount of bits indexing the secondary table
+ * the entry links to
+ */
+typedef struct huffman_entry_s
+{
+	uint32_t value;
+	unsigned char length;
+	unsigned char sub;
+} huffman_entry_t;
+
+/**
+ * struct huffman_thread_stats_s - Work done by one thread of a pool
+ *
+ * @blocks: Amount of blocks the thread coded
+ * @bytes_in: Amount of bytes it read from the blocks
+ * @bytes_out: Amount of bytes it wrote
+ * @seconds: Time it spent coding, waiting excluded
+ */
+typedef struct huffman_thread_stats_s
+{
+	size_t blocks;
+	uint64_t bytes_in;
+	uint64_t bytes_out;
+	double seconds;
+} huffman_thread_stats_t;
+
+/**
+ * struct huffman_dict_s - Shared code table
+ *
+ * @lengths: Code length of each byte value and of the escape symbol, 0 for
+ * symbols without a code
+ * @codes: Code of each byte value and of the escape symbol
+ * @decode: Decoding table, indexed by the next HUFFMAN_DICT_BITS bits of a
+ * message: the length of the code in the high bits, above the 9 bits of
+ * its symbol
+ */
+typedef struct huffman_dict_s
+{
+	unsigned char lengths[HUFFMAN_SYMBOLS + 1];
+	huffman_code_t codes[HUFFMAN_SYMBOLS + 1];
+	uint16_t decode[1 << HUFFMAN_DICT_BITS];
+} huffman_dict_t;
+
+/**
+ * struct huffman_table_s - Code table of a symbol alphabet
+ *
+ * @lengths: Code length of each symbol, 0 for symbols without a code
+ * @codes: Code of each symbol
+ * @decode: Allocated decoding table, NULL when it fits in @stack
+ * @stack: Decoding table of codes whose secondary tables are small
+ */
+typedef struct huffman_table_s
+{
+	unsigned char lengths[HUFFMAN_ALPHABET_MAX];
+	huffman_code_t codes[HUFFMAN_ALPHABET_MAX];
+	huffman_entry_t *decode;
+	huffman_entry_t stack[HUFFMAN_LOOKUP_STACK];
+} huffman_table_t;
+
+/**
+ * struct huffman_flat_s - Huffman tree held in flat arrays, its nodes
+ * named by index: leaf i stands for symbol i of the input, the merged
+ * nodes follow in the order they were made, and the root comes last
+ *
+ * @parent: Parent of each node, HUFFMAN_FLAT_NONE for the root
+ * @left: Left child of each merged node, HUFFMAN_FLAT_NONE for leaves
+ * @right: Right child of each merged node, HUFFMAN_FLAT_NONE for leaves
+ * @weight: Frequency of each node
+ * @symbol: Symbol of each leaf
+ * @order: Leaves by increasing weight, ties in input order
+ * @size: Amount of leaves
+ * @root: Index of the root
+ */
+typedef struct huffman_flat_s
+{
+	uint16_t parent[HUFFMAN_FLAT_NODES];
+	uint16_t left[HUFFMAN_FLAT_NODES];
+	uint16_t right[HUFFMAN_FLAT_NODES];
+	size_t weight[HUFFMAN_FLAT_NODES];
+	uint16_t symbol[HUFFMAN_ALPHABET_MAX];
+	uint16_t order[HUFFMAN_ALPHABET_MAX];
+	size_t size;
+	size_t root;
+} huffman_flat_t;
+
+/**
+ * struct huffman_params_s - Stream options, 0 in any field selecting its
+ * default
+ *
+ * @max_code_length: Longest code allowed, from 1 to HUFFMAN_MAX_BITS;
+ * shorter limits make decoding tables smaller, at a small cost in
+ * compression (default HUFFMAN_DEFAULT_MAX_BITS)
+ * @block_size: Amount of input coded with each code table by the stream
+ * functions, at most HUFFMAN_BLOCK_MAX (default HUFFMAN_BLOCK_DEFAULT)
+ * @threads: Amount of threads the stream functions code blocks with, at
+ * most HUFFMAN_THREADS_MAX (default 1, coding in the caller's thread)
+ * @stats: If not NULL, array of @threads entries the stream functions
+ * fill with the work of each thread
+ * @streams: Bit streams per block, 1 or HUFFMAN_STREAMS; more streams
+ * decode faster, at 12 bytes per block (default HUFFMAN_STREAMS for blocks
+ * of at least HUFFMAN_STREAMS_MIN bytes, 1 for smaller ones)
+ * @index_interval: If not 0, the compressed stream ends with a seek index
+ * holding one entry every @index_interval blocks, for huffman_read_range();
+ * 1 indexes every block, larger values trade seeking work for a smaller
+ * index (default 0, no index)
+ */
+typedef struct huffman_params_s
+{
+	unsigned int max_code_length;
+	size_t block_size;
+	unsigned int threads;
+	huffman_thread_stats_t *stats;
+	unsigned int streams;
+	unsigned int index_interval;
+} huffman_params_t;
+
+/**
+ * huffman_read_t - Input callback of the stream functions
+ *
+ * @ctx: Caller's context
+ * @buf: Buffer to fill
+ * @n: Length of @buf
+ * Return: amount of bytes read, 0 at the end of the input, or HUFFMAN_ERROR
+ */
+typedef size_t (*huffman_read_t)(void *ctx, uint8_t *buf, size_t n);
+
+/**
+ * huffman_write_t - Output callback of the stream functions
+ *
+ * @ctx: Caller's context
+ * @buf: Bytes to write
+ * @n: Length of @buf
+ * Return: 1 if all of @buf was written, 0 on failure
+ */
+typedef int (*huffman_write_t)(void *ctx, const uint8_t *buf, size_t n);
+
+/**
+ * huffman_job_t - Work a pool runs on each block
+ *
+ * @ctx: Caller's context
+ * @in: Block read by the pool's fill callback
+ * @n: Length of @in
+ * @out: Output buffer
+ * @cap: Length of @out
+ * Return: amount of bytes written to @out, or HUFFMAN_ERROR
+ */
+typedef size_t (*huffman_job_t)(void *ctx, const uint8_t *in, size_t n,
+				uint8_t *out, size_t cap);
+
+/**
+ * struct huffman_pool_s - Describes the work of huffman_pool_run()
+ *
+ * @threads: Amount of worker threads, from 1 to HUFFMAN_THREADS_MAX
+ * @in_size: Largest block @fill reads
+ * @out_size: Largest output @job writes
+ * @fill: Reads the next block, in the caller's thread; returns 0 once
+ * there are no more blocks
+ * @fill_ctx: Context of @fill
+ * @job: Codes one block, in a worker thread
+ * @job_ctx: Context of @job, shared by all the workers
+ * @wr: Writes the output of each block, in the caller's thread and in the
+ * order @fill read the blocks
+ * @wr_ctx: Context of @wr
+ * @stats: If not NULL, array of @threads entries filled with the work of
+ * each worker
+ */
+typedef struct huffman_pool_s
+{
+	unsigned int threads;
+	size_t in_size;
+	size_t out_size;
+	huffman_read_t fill;
+	void *fill_ctx;
+	huffman_job_t job;
+	void *job_ctx;
+	huffman_write_t wr;
+	void *wr_ctx;
+	huffman_thread_stats_t *stats;
+} huffman_pool_t;
+
+symbol_t *symbol_create(uint16_t data, size_t freq);
+symbol_t *symbol_internal(size_t freq);
+heap_t *huffman_priority_queue(uint16_t *data, size_t *freq, size_t size);
 int huffman_extract_and_insert(heap_t *priority_queue);
-binary_tree_node_t *huffman_tree(char *data, size_t *freq, size_t size);
-int huffman_codes(char *data, size_t *freq, size_t size);
+binary_tree_node_t *huffman_tree(uint16_t *data, size_t *freq, size_t size);
+int huffman_codes(uint16_t *data, size_t *freq, size_t size);
+int huffman_flat_tree(const uint16_t *data, const size_t *freq, size_t size,
+		      huffman_flat_t *tree);
+int huffman_flat_lengths(const huffman_flat_t *tree, unsigned char *lengths);
+int huffman_tree_lengths(const binary_tree_node_t *root,
+			 unsigned char *lengths);
+size_t *huffman_sort(size_t *freq, size_t size);
+int huffman_code_lengths(size_t *freq, size_t size, unsigned char *lengths);
+int huffman_code_lengths_limited(size_t *freq, size_t size,
+				 unsigned char *lengths,
+				 unsigned int max_length);
+int huffman_histogram(const uint8_t *in, size_t n, size_t *freq);
+size_t huffman_entropy_bits(const size_t *freq, size_t size);
+int huffman_canonical_codes(const unsigned char *lengths, size_t size,
+			    huffman_code_t *table);
+size_t huffman_lengths_write(const unsigned char *lengths, size_t size,
+			     uint8_t *out);
+size_t huffman_lengths_read(const uint8_t *in, size_t n, size_t size,
+			    unsigned char *lengths);
+size_t huffman_encode_bound(size_t n);
+size_t huffman_encode(const uint8_t *in, size_t n, uint8_t *out, size_t cap);
+size_t huffman_encode_params(const uint8_t *in, size_t n, uint8_t *out,
+			     size_t cap, const huffman_params_t *params);
+size_t huffman_decoded_size(const uint8_t *in, size_t n);
+size_t huffman_decode(const uint8_t *in, size_t n, uint8_t *out, size_t cap);
+size_t huffman_block_size(const huffman_params_t *params);
+size_t huffman_stream_header(uint8_t *out, size_t block_size);
+size_t huffman_stream_block(const uint8_t *head);
+size_t huffman_frame_bound(size_t block_size);
+size_t huffman_frame_encode(const uint8_t *in, size_t n, uint8_t *out,
+			    size_t cap, const huffman_params_t *params);
+int huffman_compress_stream(huffman_read_t rd, void *rctx,
+			    huffman_write_t wr, void *wctx,
+			    const huffman_params_t *params);
+int huffman_decompress_stream(huffman_read_t rd, void *rctx,
+			      huffman_write_t wr, void *wctx,
+			      const huffman_params_t *params);
+int huffman_compress_fd(int in_fd, int out_fd, const huffman_params_t *params);
+int huffman_decompress_fd(int in_fd, int out_fd,
+			  const huffman_params_t *params);
+size_t huffman_read_range(int fd, uint64_t off, size_t len, uint8_t *out);
+int huffman_dict_train(const uint8_t *samples, size_t n, int escape,
+		       huffman_dict_t *dict);
+size_t huffman_dict_save(const huffman_dict_t *dict, uint8_t *out);
+size_t huffman_dict_load(const uint8_t *in, size_t n, huffman_dict_t *dict);
+size_t huffman_dict_bound(size_t n);
+size_t huffman_dict_encode(const huffman_dict_t *dict, const uint8_t *in,
+			   size_t n, uint8_t *out, size_t cap);
+size_t huffman_dict_decode(const huffman_dict_t *dict, const uint8_t *in,
+			   size_t n, uint8_t *out, size_t cap);
+int huffman_table_build(const unsigned char *lengths, size_t size,
+			huffman_table_t *table);
+size_t huffman_table_save(const huffman_table_t *table, uint8_t *out);
+size_t huffman_table_load(const uint8_t *in, size_t n,
+			  huffman_table_t *table);
+size_t huffman_table_encode(const huffman_table_t *table, const uint16_t *in,
+			    size_t count, uint8_t *out, size_t cap);
+size_t huffman_table_decode(const huffman_table_t *table, const uint8_t *in,
+			    size_t n, uint16_t *out, size_t count);
+void huffman_table_free(huffman_table_t *table);
+int huffman_lookup_build(size_t nsym, const uint16_t *sym,
+			 const unsigned char *len, const uint32_t *code,
+			 huffman_entry_t *stack, huffman_entry_t **table);
+int huffman_pool_run(const huffman_pool_t *pool);
+int huffman_adaptive_compress(huffman_read_t rd, void *rctx,
+			      huffman_write_t wr, void *wctx);
+int huffman_adaptive_decompress(huffman_read_t rd, void *rctx,
+				huffman_write_t wr, void *wctx);
+void huffman_stats_print(const huffman_thread_stats_t *stats,
+			 unsigned int threads);
+
+/**
+ * huffman_lookup - resolves the next code of a bit stream in a table built
+ * by huffman_lookup_build(): one primary table load, two for long codes
+ * @t: decoding table
+ * @bits: next bits of the stream, first one in the low end, at least as
+ * many as the longest code
+ * Return: huffman_entry_t entry of the code, of length 0 if it does not
+ * exist
+ */
+static inline huffman_entry_t huffman_lookup(const huffman_entry_t *t,
+					     uint64_t bits)
+{
+	huffman_entry_t e = t[bits & ((1U << HUFFMAN_LOOKUP_BITS) - 1)];
 
+	if (e.sub)
+		e = t[e.value + ((bits >> HUFFMAN_LOOKUP_BITS) &
+				 ((1U << e.sub) - 1))];
+	return (e);
+}
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wvariadic-macros"
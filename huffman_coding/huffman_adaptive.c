@@ -0,0 +1,494 @@
+#include "huffman.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* a leaf per byte value and the 0-node, and the internal nodes above them */
+#define ADAPTIVE_NODES	(2 * HUFFMAN_SYMBOLS + 1)
+/* literal sent after the 0-node code: a byte value, or ADAPTIVE_END */
+#define LITERAL_BITS	9
+#define ADAPTIVE_END	HUFFMAN_SYMBOLS
+#define IO_BUFFER	4096
+
+/**
+ * struct adaptive_s - Vitter's dynamic Huffman tree
+ *
+ * Nodes carry an implicit number: weights never decrease with the number,
+ * the leaves of a weight come right before its internal nodes (each such
+ * run of nodes is a block), and the root has the highest number. Encoder
+ * and decoder apply the same updates, so their trees stay identical.
+ * Each block keeps its leader, its highest number, so that an update
+ * costs the same amount of steps on every level of the tree.
+ *
+ * @nodes: Tree nodes, allocated from the start
+ * @symbols: Data of @nodes, freq being the weight of the node
+ * @number: Implicit number of each of @nodes
+ * @order: Node of each implicit number
+ * @block: Block of each implicit number
+ * @leader: Highest implicit number of each block
+ * @spare: Blocks not in use
+ * @nb_spare: Amount of @spare
+ * @leaf: Leaf of each byte value, NULL until it first occurs
+ * @root: Root of the tree
+ * @zero: The 0-node, leaf standing for every byte value not seen yet
+ * @used: Amount of @nodes in the tree
+ */
+typedef struct adaptive_s
+{
+	binary_tree_node_t nodes[ADAPTIVE_NODES];
+	symbol_t symbols[ADAPTIVE_NODES];
+	size_t number[ADAPTIVE_NODES];
+	binary_tree_node_t *order[ADAPTIVE_NODES];
+	size_t block[ADAPTIVE_NODES];
+	size_t leader[ADAPTIVE_NODES];
+	size_t spare[ADAPTIVE_NODES];
+	size_t nb_spare;
+	binary_tree_node_t *leaf[HUFFMAN_SYMBOLS];
+	binary_tree_node_t *root;
+	binary_tree_node_t *zero;
+	size_t used;
+} adaptive_t;
+
+/**
+ * struct bit_io_s - Bit buffer over a read or a write callback
+ *
+ * @buf: Pending bytes
+ * @pos: Index in @buf of the byte being read or written
+ * @len: Amount of bytes in @buf, when reading
+ * @bit: Index in buf[@pos] of the next bit
+ * @rd: Input callback, when reading
+ * @wr: Output callback, when writing
+ * @ctx: Context of the callback
+ */
+typedef struct bit_io_s
+{
+	uint8_t buf[IO_BUFFER];
+	size_t pos;
+	size_t len;
+	unsigned int bit;
+	huffman_read_t rd;
+	huffman_write_t wr;
+	void *ctx;
+} bit_io_t;
+
+/**
+ * weight - finds the weight of a node
+ * @node: node
+ * Return: pointer to the weight
+ */
+static size_t *weight(binary_tree_node_t *node)
+{
+	return (&((symbol_t *)node->data)->freq);
+}
+
+/**
+ * node_new - takes the next free node of the tree
+ * @h: tree
+ * @parent: parent of the node
+ * @number: implicit number of the node
+ * Return: pointer to the node, a leaf of weight 0
+ */
+static binary_tree_node_t *node_new(adaptive_t *h, binary_tree_node_t *parent,
+				    size_t number)
+{
+	binary_tree_node_t *node = &h->nodes[h->used];
+
+	node->data = &h->symbols[h->used];
+	node->left = node->right = NULL;
+	node->parent = parent;
+	h->symbols[h->used].data = 0;
+	h->symbols[h->used].freq = 0;
+	h->number[h->used++] = number;
+	h->order[number] = node;
+	return (node);
+}
+
+/**
+ * block_new - starts a block
+ * @h: tree
+ * @leader: implicit number of the leader, and only node, of the block
+ */
+static void block_new(adaptive_t *h, size_t leader)
+{
+	size_t b = h->spare[--h->nb_spare];
+
+	h->leader[b] = leader;
+	h->block[leader] = b;
+}
+
+/**
+ * adaptive_init - starts a tree holding the 0-node alone
+ * @h: tree
+ */
+static void adaptive_init(adaptive_t *h)
+{
+	memset(h->leaf, 0, sizeof(h->leaf));
+	for (h->nb_spare = 0; h->nb_spare < ADAPTIVE_NODES; h->nb_spare++)
+		h->spare[h->nb_spare] = h->nb_spare;
+	h->used = 0;
+	h->root = h->zero = node_new(h, NULL, ADAPTIVE_NODES - 1);
+	block_new(h, ADAPTIVE_NODES - 1);
+}
+
+/**
+ * same_block - tells whether two nodes belong to the same block
+ * @a: first node
+ * @b: second node
+ * Return: 1 if they do, 0 otherwise
+ */
+static int same_block(binary_tree_node_t *a, binary_tree_node_t *b)
+{
+	return (*weight(a) == *weight(b) && !a->left == !b->left);
+}
+
+/**
+ * node_swap - exchanges the places in the tree, and the numbers, of two
+ * nodes neither of which is an ancestor of the other
+ * @h: tree
+ * @a: first node
+ * @b: second node
+ */
+static void node_swap(adaptive_t *h, binary_tree_node_t *a,
+		      binary_tree_node_t *b)
+{
+	binary_tree_node_t *pa = a->parent, *pb = b->parent, **sa, **sb, *t;
+	size_t na = h->number[a - h->nodes], nb = h->number[b - h->nodes];
+
+	sa = pa->left == a ? &pa->left : &pa->right;
+	sb = pb->left == b ? &pb->left : &pb->right;
+	*sa = b;
+	*sb = a;
+	t = a->parent;
+	a->parent = b->parent;
+	b->parent = t;
+	h->number[a - h->nodes] = nb;
+	h->number[b - h->nodes] = na;
+	h->order[nb] = a;
+	h->order[na] = b;
+}
+
+/**
+ * block_leader - finds the highest numbered node of a node's block
+ * @h: tree
+ * @node: node
+ * Return: pointer to the leader
+ */
+static binary_tree_node_t *block_leader(adaptive_t *h,
+					binary_tree_node_t *node)
+{
+	return (h->order[h->leader[h->block[h->number[node - h->nodes]]]]);
+}
+
+/**
+ * slide_and_increment - moves a node to the top of its block, then past
+ * the block that would come before it once its weight grows, then grows
+ * it; the nodes of a block being alike, each move is a single swap with
+ * the leader of a block
+ * @h: tree
+ * @p: node, neither an ancestor nor a descendant of its leader
+ * Return: pointer to the next node to increment, NULL past the root
+ */
+static binary_tree_node_t *slide_and_increment(adaptive_t *h,
+					       binary_tree_node_t *p)
+{
+	binary_tree_node_t *parent = p->parent, *next;
+	size_t w = *weight(p), k = h->number[p - h->nodes], b = h->block[k], c;
+	int slide = 0, alone;
+
+	if (k + 1 < ADAPTIVE_NODES && h->block[k + 1] == b)
+	{
+		node_swap(h, p, h->order[h->leader[b]]);
+		parent = p->parent;
+		k = h->leader[b];
+	}
+	/* the 0-node is never grown, so a lower number is always in use */
+	alone = h->block[k - 1] != b;
+	if (!alone)
+		h->leader[b] = k - 1;
+	if (k + 1 < ADAPTIVE_NODES)
+	{
+		next = h->order[k + 1];
+		slide = p->left ? !next->left && *weight(next) == w + 1 :
+			next->left && *weight(next) == w;
+	}
+	if (slide)
+	{
+		c = h->block[k + 1];
+		node_swap(h, p, h->order[h->leader[c]]);
+		h->block[k] = c;
+		k = h->leader[c]--;
+	}
+	(*weight(p))++;
+	if (k + 1 < ADAPTIVE_NODES && same_block(h->order[k + 1], p))
+	{
+		h->block[k] = h->block[k + 1];
+		if (alone)
+			h->spare[h->nb_spare++] = b;
+	}
+	else if (!alone)
+		block_new(h, k);
+	else if (slide)
+	{
+		h->block[k] = b;
+		h->leader[b] = k;
+	}
+	return (p->left ? parent : p->parent);
+}
+
+/**
+ * adaptive_update - counts one more occurrence of a byte value, keeping
+ * the tree a Huffman tree of the counts (Vitter's algorithm Lambda)
+ * @h: tree
+ * @symbol: byte value
+ */
+static void adaptive_update(adaptive_t *h, uint8_t symbol)
+{
+	binary_tree_node_t *q = h->leaf[symbol], *last = NULL, *zero;
+	size_t number;
+
+	if (!q)
+	{
+		/* the 0-node gives birth to a new 0-node and the new leaf */
+		zero = h->zero;
+		number = h->number[zero - h->nodes];
+		zero->right = node_new(h, zero, number - 1);
+		zero->left = node_new(h, zero, number - 2);
+		block_new(h, number - 1);
+		h->block[number - 2] = h->block[number - 1];
+		((symbol_t *)zero->right->data)->data = (uint16_t)symbol;
+		h->leaf[symbol] = last = zero->right;
+		h->zero = zero->left;
+		q = zero;
+	}
+	else
+	{
+		zero = block_leader(h, q);
+		if (zero != q)
+			node_swap(h, q, zero);
+		if (q->parent && (q->parent->left == h->zero ||
+				  q->parent->right == h->zero))
+		{
+			last = q;
+			q = q->parent;
+		}
+	}
+	while (q)
+		q = slide_and_increment(h, q);
+	if (last)
+		slide_and_increment(h, last);
+}
+
+/**
+ * bit_put - appends a bit to the output, handing every IO_BUFFER whole
+ * bytes to the output callback
+ * @io: bit buffer
+ * @bit: bit
+ * Return: int 1 on success, 0 if the callback failed
+ */
+static int bit_put(bit_io_t *io, unsigned int bit)
+{
+	io->buf[io->pos] |= (uint8_t)(bit << io->bit);
+	if (++io->bit < 8)
+		return (1);
+	io->bit = 0;
+	if (++io->pos == IO_BUFFER)
+	{
+		if (!io->wr(io->ctx, io->buf, IO_BUFFER))
+			return (0);
+		io->pos = 0;
+	}
+	io->buf[io->pos] = 0;
+	return (1);
+}
+
+/**
+ * bit_drain - hands the whole bytes written so far to the output callback,
+ * keeping the byte being filled
+ * @io: bit buffer
+ * Return: int 1 on success, 0 if the callback failed
+ */
+static int bit_drain(bit_io_t *io)
+{
+	if (!io->pos)
+		return (1);
+	if (!io->wr(io->ctx, io->buf, io->pos))
+		return (0);
+	io->buf[0] = io->buf[io->pos];
+	io->pos = 0;
+	return (1);
+}
+
+/**
+ * bit_get - reads the next bit of the input
+ * @io: bit buffer
+ * Return: int the bit, or -1 if the input ended or failed
+ */
+static int bit_get(bit_io_t *io)
+{
+	int bit;
+
+	if (io->pos == io->len)
+	{
+		io->len = io->rd(io->ctx, io->buf, IO_BUFFER);
+		if (!io->len || io->len == HUFFMAN_ERROR)
+			return (-1);
+		io->pos = 0;
+	}
+	bit = io->buf[io->pos] >> io->bit & 1;
+	if (++io->bit == 8)
+	{
+		io->bit = 0;
+		io->pos++;
+	}
+	return (bit);
+}
+
+/**
+ * encode_symbol - writes the code of a symbol, from the root down: the
+ * code of its leaf, or the code of the 0-node then the symbol as a literal
+ * the first time it occurs
+ * @h: tree
+ * @io: bit buffer
+ * @symbol: byte value, or ADAPTIVE_END
+ * Return: int 1 on success, 0 if the output callback failed
+ */
+static int encode_symbol(adaptive_t *h, bit_io_t *io, unsigned int symbol)
+{
+	unsigned char path[ADAPTIVE_NODES];
+	int literal = symbol == ADAPTIVE_END || !h->leaf[symbol], ok = 1;
+	binary_tree_node_t *node = literal ? h->zero : h->leaf[symbol];
+	size_t depth = 0;
+	unsigned int i;
+
+	for (; node->parent; node = node->parent)
+		path[depth++] = node->parent->right == node;
+	while (depth && ok)
+		ok = bit_put(io, path[--depth]);
+	if (literal)
+		for (i = 0; i < LITERAL_BITS && ok; i++)
+			ok = bit_put(io, symbol >> i & 1);
+	return (ok);
+}
+
+/**
+ * huffman_adaptive_compress - compresses an input in a single pass with a
+ * Huffman code that adapts to the bytes seen so far (Vitter's algorithm),
+ * with no code table to send and no look-ahead: memory use is constant,
+ * and every byte read is coded before the next read, the whole bytes of
+ * output being written right away
+ * @rd: input callback
+ * @rctx: context of @rd
+ * @wr: output callback
+ * @wctx: context of @wr
+ * Return: int 1 on success, 0 on failure
+ */
+int huffman_adaptive_compress(huffman_read_t rd, void *rctx,
+			      huffman_write_t wr, void *wctx)
+{
+	adaptive_t *h = malloc(sizeof(*h));
+	bit_io_t *io = calloc(1, sizeof(*io));
+	uint8_t in[IO_BUFFER];
+	size_t n, i;
+	int ok = rd && wr && h && io;
+
+	if (ok)
+	{
+		adaptive_init(h);
+		io->wr = wr;
+		io->ctx = wctx;
+	}
+	while (ok && (n = rd(rctx, in, IO_BUFFER)) != 0)
+	{
+		ok = n != HUFFMAN_ERROR;
+		for (i = 0; ok && i < n; i++)
+		{
+			ok = encode_symbol(h, io, in[i]);
+			adaptive_update(h, in[i]);
+		}
+		ok = ok && bit_drain(io);
+	}
+	ok = ok && encode_symbol(h, io, ADAPTIVE_END) && bit_drain(io) &&
+		(!io->bit || wr(wctx, io->buf, 1));
+	free(h);
+	free(io);
+	return (ok);
+}
+
+/**
+ * decode_symbol - reads a code, walking the tree from the root one bit at
+ * a time, and the literal following the code of the 0-node
+ * @h: tree
+ * @io: bit buffer
+ * Return: int byte value, ADAPTIVE_END, or -1 if the input ended or failed
+ */
+static int decode_symbol(adaptive_t *h, bit_io_t *io)
+{
+	binary_tree_node_t *node = h->root;
+	int bit, symbol = 0;
+	unsigned int i;
+
+	while (node->left)
+	{
+		bit = bit_get(io);
+		if (bit < 0)
+			return (-1);
+		node = bit ? node->right : node->left;
+	}
+	if (node != h->zero)
+		return ((uint8_t)((symbol_t *)node->data)->data);
+	for (i = 0; i < LITERAL_BITS; i++)
+	{
+		bit = bit_get(io);
+		if (bit < 0)
+			return (-1);
+		symbol |= bit << i;
+	}
+	/* a literal may only stand for a byte value not seen yet */
+	if (symbol < ADAPTIVE_END && h->leaf[symbol])
+		return (-1);
+	return (symbol);
+}
+
+/**
+ * huffman_adaptive_decompress - decompresses a stream written by
+ * huffman_adaptive_compress(), in a single pass and constant memory; the
+ * bytes decoded are written out whenever the input read so far runs out
+ * @rd: input callback
+ * @rctx: context of @rd
+ * @wr: output callback
+ * @wctx: context of @wr
+ * Return: int 1 on success, 0 on failure or if the stream is corrupt
+ */
+int huffman_adaptive_decompress(huffman_read_t rd, void *rctx,
+				huffman_write_t wr, void *wctx)
+{
+	adaptive_t *h = malloc(sizeof(*h));
+	bit_io_t *io = calloc(1, sizeof(*io));
+	uint8_t out[IO_BUFFER];
+	size_t n = 0;
+	int ok = rd && wr && h && io, symbol = 0;
+
+	if (ok)
+	{
+		adaptive_init(h);
+		io->rd = rd;
+		io->ctx = rctx;
+	}
+	while (ok)
+	{
+		/* hand over what is decoded before waiting for more input */
+		if (n == IO_BUFFER || (n && io->pos == io->len))
+		{
+			ok = wr(wctx, out, n);
+			n = 0;
+		}
+		symbol = decode_symbol(h, io);
+		if (!ok || symbol < 0 || symbol == ADAPTIVE_END)
+			break;
+		adaptive_update(h, (uint8_t)symbol);
+		out[n++] = (uint8_t)symbol;
+	}
+	ok = ok && symbol == ADAPTIVE_END && (!n || wr(wctx, out, n));
+	free(h);
+	free(io);
+	return (ok);
+}
@@ -0,0 +1,191 @@
+#include "huffman.h"
+#include <string.h>
+
+/* code length header nibbles: 0 to NIBBLE_LITERALS - 1 are lengths, */
+/* NIBBLE_ZEROS is followed by two nibbles counting a run of zeros, and */
+/* NIBBLE_LONG by two nibbles holding a length too large for one nibble */
+#define NIBBLE_LITERALS	14
+#define NIBBLE_ZEROS	14
+#define NIBBLE_LONG	15
+#define ZERO_RUN_MIN	3
+#define ZERO_RUN_MAX	(ZERO_RUN_MIN + 255)
+
+/**
+ * huffman_canonical_codes - assigns canonical prefix codes from code
+ * lengths alone: shorter codes first, and for a given length in order of
+ * symbol value, so that a decoder holding only the lengths rebuilds the
+ * same codes
+ * @lengths: code length of each symbol, 0 if it is not coded
+ * @size: size_t amount of symbols
+ * @table: receives the code of each symbol, bit-reversed for the bit writer
+ * Return: int 1 on success, 0 if the lengths exceed HUFFMAN_MAX_BITS or
+ * do not describe a prefix code
+ */
+int huffman_canonical_codes(const unsigned char *lengths, size_t size,
+			    huffman_code_t *table)
+{
+	uint64_t next[HUFFMAN_MAX_BITS + 1] = {0}, code, kraft = 0;
+	size_t count[HUFFMAN_MAX_BITS + 1] = {0}, i, len;
+	uint32_t rev;
+
+	if (!lengths || !table)
+		return (0);
+	for (i = 0; i < size; i++)
+	{
+		if (lengths[i] > HUFFMAN_MAX_BITS)
+			return (0);
+		count[lengths[i]]++;
+	}
+	count[0] = 0;
+	/* counting pass: first code of each length */
+	for (len = 1, code = 0; len <= HUFFMAN_MAX_BITS; len++)
+	{
+		code = (code + count[len - 1]) << 1;
+		next[len] = code;
+		kraft += (uint64_t)count[len] << (HUFFMAN_MAX_BITS - len);
+	}
+	if (kraft > (uint64_t)1 << HUFFMAN_MAX_BITS)
+		return (0);
+	for (i = 0; i < size; i++)
+	{
+		table[i].length = lengths[i];
+		table[i].bits = 0;
+		if (!lengths[i])
+			continue;
+		code = next[lengths[i]]++;
+		for (len = 0, rev = 0; len < lengths[i]; len++, code >>= 1)
+			rev = (rev << 1) | (code & 1);
+		table[i].bits = rev;
+	}
+	return (1);
+}
+
+/**
+ * nibble_put - appends a nibble to a header, low nibble of a byte first
+ * @out: header
+ * @pos: amount of nibbles already in @out, incremented
+ * @v: nibble
+ */
+static void nibble_put(uint8_t *out, size_t *pos, unsigned int v)
+{
+	if (*pos % 2)
+		out[*pos / 2] |= (uint8_t)(v << 4);
+	else
+		out[*pos / 2] = (uint8_t)v;
+	(*pos)++;
+}
+
+/**
+ * huffman_lengths_write - packs code lengths into a block header: the last
+ * coded symbol, on one byte for alphabets of up to 256 symbols and two
+ * otherwise, then a nibble per length, with runs of zeros and lengths
+ * over 13 escaped; a text block's header takes a few dozen bytes
+ * @lengths: code length of each symbol
+ * @size: size_t amount of symbols, at most HUFFMAN_ALPHABET_MAX
+ * @out: receives the header, HUFFMAN_LENGTHS_BOUND(@size) bytes are always
+ * enough
+ * Return: size_t amount of bytes written
+ */
+size_t huffman_lengths_write(const unsigned char *lengths, size_t size,
+			     uint8_t *out)
+{
+	size_t last = size - 1, i, run, pos = 0;
+
+	while (last > 0 && !lengths[last])
+		last--;
+	*out++ = (uint8_t)last;
+	if (size > HUFFMAN_SYMBOLS)
+		*out++ = (uint8_t)(last >> 8);
+	for (i = 0; i <= last; i += run)
+	{
+		for (run = 0; i + run <= last && !lengths[i + run] &&
+			     run < ZERO_RUN_MAX; run++)
+			;
+		if (run >= ZERO_RUN_MIN)
+		{
+			nibble_put(out, &pos, NIBBLE_ZEROS);
+			nibble_put(out, &pos, (run - ZERO_RUN_MIN) >> 4);
+			nibble_put(out, &pos, (run - ZERO_RUN_MIN) & 15);
+			continue;
+		}
+		run = 1;
+		if (lengths[i] < NIBBLE_LITERALS)
+			nibble_put(out, &pos, lengths[i]);
+		else
+		{
+			nibble_put(out, &pos, NIBBLE_LONG);
+			nibble_put(out, &pos, lengths[i] >> 4);
+			nibble_put(out, &pos, lengths[i] & 15);
+		}
+	}
+	return ((size > HUFFMAN_SYMBOLS ? 2 : 1) + (pos + 1) / 2);
+}
+
+/**
+ * nibble_get - reads the next nibble of a header
+ * @in: header
+ * @n: size_t length of @in
+ * @pos: amount of nibbles already read, incremented
+ * Return: the nibble, or -1 past the end of @in
+ */
+static int nibble_get(const uint8_t *in, size_t n, size_t *pos)
+{
+	int v;
+
+	if (*pos / 2 >= n)
+		return (-1);
+	v = (in[*pos / 2] >> (*pos % 2 * 4)) & 15;
+	(*pos)++;
+	return (v);
+}
+
+/**
+ * huffman_lengths_read - unpacks code lengths written by
+ * huffman_lengths_write()
+ * @in: header
+ * @n: size_t length of @in
+ * @size: size_t amount of symbols, as given to huffman_lengths_write()
+ * @lengths: receives the code length of each symbol
+ * Return: size_t amount of bytes read, 0 if the header is corrupt
+ */
+size_t huffman_lengths_read(const uint8_t *in, size_t n, size_t size,
+			    unsigned char *lengths)
+{
+	size_t last, head = size > HUFFMAN_SYMBOLS ? 2 : 1, i = 0, pos = 0;
+	int a, b, c;
+
+	if (!in || n < head || !size || !lengths)
+		return (0);
+	memset(lengths, 0, size);
+	last = in[0];
+	if (head == 2)
+		last |= (size_t)in[1] << 8;
+	if (last >= size)
+		return (0);
+	in += head;
+	n -= head;
+	while (i <= last)
+	{
+		a = nibble_get(in, n, &pos);
+		if (a < 0)
+			return (0);
+		if (a < NIBBLE_LITERALS)
+		{
+			lengths[i++] = (unsigned char)a;
+			continue;
+		}
+		b = nibble_get(in, n, &pos);
+		c = nibble_get(in, n, &pos);
+		if (b < 0 || c < 0)
+			return (0);
+		c |= b << 4;
+		if (a == NIBBLE_ZEROS &&
+		    (size_t)c + ZERO_RUN_MIN <= last + 1 - i)
+			i += (size_t)c + ZERO_RUN_MIN;
+		else if (a == NIBBLE_LONG && c <= HUFFMAN_MAX_BITS)
+			lengths[i++] = (unsigned char)c;
+		else
+			return (0);
+	}
+	return (head + (pos + 1) / 2);
+}
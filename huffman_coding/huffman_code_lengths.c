@@ -0,0 +1,111 @@
+#include "huffman.h"
+#include <stdlib.h>
+
+/**
+ * code_lengths_in_place - turns frequencies sorted in increasing order into
+ * Huffman code lengths, in the same array, without building a tree
+ * (Moffat and Katajainen, "In-Place Calculation of Minimum-Redundancy
+ * Codes", 1995): the first pass merges nodes left to right, leaving parent
+ * indices behind; the second turns those into internal node depths; the
+ * third hands out leaf depths from the shallowest level down
+ * @a: frequencies in increasing order, at least two of them; receives the
+ * code lengths, in decreasing order
+ * @n: length of @a
+ */
+static void code_lengths_in_place(size_t *a, size_t n)
+{
+	size_t root = 0, leaf = 2, next, avbl, used, dpth;
+
+	/* first pass, left to right, setting parent pointers */
+	a[0] += a[1];
+	for (next = 1; next < n - 1; next++)
+	{
+		if (leaf >= n || a[root] < a[leaf])
+		{
+			a[next] = a[root];
+			a[root++] = next;
+		}
+		else
+			a[next] = a[leaf++];
+		if (leaf >= n || (root < next && a[root] < a[leaf]))
+		{
+			a[next] += a[root];
+			a[root++] = next;
+		}
+		else
+			a[next] += a[leaf++];
+	}
+
+	/* second pass, right to left, setting internal depths */
+	a[n - 2] = 0;
+	for (next = n - 2; next-- > 0; )
+		a[next] = a[a[next]] + 1;
+
+	/* third pass, right to left, setting leaf depths */
+	/* root and next count one past the index they stand for */
+	avbl = 1;
+	used = dpth = 0;
+	root = n - 1;
+	next = n;
+	while (avbl > 0)
+	{
+		while (root > 0 && a[root - 1] == dpth)
+		{
+			used++;
+			root--;
+		}
+		while (avbl > used)
+		{
+			a[--next] = dpth;
+			avbl--;
+		}
+		avbl = 2 * used;
+		dpth++;
+		used = 0;
+	}
+}
+
+/**
+ * huffman_code_lengths - computes the Huffman code length of every symbol,
+ * with no tree nodes: frequencies are radix sorted, and the lengths are
+ * then computed in place in one array
+ * @freq: frequency array
+ * @size: size_t length of @freq and @lengths
+ * @lengths: receives the code length of each symbol; 0 for symbols of
+ * frequency 0, and 1 for the only symbol if there is just one
+ * Return: int 1 on success, 0 on failure
+ */
+int huffman_code_lengths(size_t *freq, size_t size, unsigned char *lengths)
+{
+	size_t *order, *a, i, n = 0, skip;
+
+	if (!freq || !size || !lengths)
+		return (0);
+
+	order = huffman_sort(freq, size);
+	a = malloc(sizeof(*a) * size);
+	if (!order || !a)
+	{
+		free(order);
+		free(a);
+		return (0);
+	}
+	for (i = 0; i < size; i++)
+	{
+		lengths[i] = 0;
+		if (freq[order[i]])
+			a[n++] = freq[order[i]];
+	}
+	skip = size - n;
+	if (n == 1)
+		lengths[order[skip]] = 1;
+	else if (n > 1)
+	{
+		code_lengths_in_place(a, n);
+		for (i = 0; i < n; i++)
+			lengths[order[skip + i]] = (unsigned char)a[i];
+	}
+	free(order);
+	free(a);
+	return (1);
+}
@@ -1,36 +1,35 @@
-
 #include "huffman.h"
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 /**
- * print_leaf_data - description
- * @buffer: char buffer for writing huffman code for leaf
+ * print_leaf_data - prints the code of every leaf of a Huffman subtree;
+ * printable ASCII symbols as characters, any other symbol as its value
+ * @code: code of @node, HUFFMAN_ALPHABET_MAX bytes for the deepest trees
+ * @depth: length of the code of @node
  * @node: node_t root of huffman subtree
  */
-void print_leaf_data(char *buffer, node_t *node)
+static void print_leaf_data(char *code, size_t depth, node_t *node)
 {
-	if (!node) return;
+	symbol_t *s;
 
-	if (node->left)
-	{
-		char buf[256] = {0};
-		char *fmt = (buffer) ? "%s0" : "0";
-		sprintf((char *)&buf, fmt, buffer);
-		print_leaf_data((char *)&buf, node->left);
-	}
-	if (node->right)
+	if (!node)
+		return;
+	if (node->left || node->right)
 	{
-		char buf[256] = {0};
-		char *fmt = (buffer) ? "%s1" : "1";
-		sprintf((char *)&buf, fmt, buffer);
-		print_leaf_data((char *)&buf, node->right);
-	}
-	if (!node->left && !node->right)
-	{
-		char c = ((symbol_t *)node->data)->data;
-		printf("%c: %s\n", c, buffer);
+		code[depth] = '0';
+		print_leaf_data(code, depth + 1, node->left);
+		code[depth] = '1';
+		print_leaf_data(code, depth + 1, node->right);
+		return;
 	}
+	code[depth] = '\0';
+	s = node->data;
+	if (s->data < 0x80 && isprint(s->data))
+		printf("%c: %s\n", s->data, code);
+	else
+		printf("%u: %s\n", s->data, code);
 }
 
 /**
@@ -46,11 +45,17 @@ void print_leaf_data(char *buffer, node_t *node)
  * @size: size
  * Return: int 1 on success, 0 on failure
  */
-int huffman_codes(char *data, size_t *freq, size_t size)
+int huffman_codes(uint16_t *data, size_t *freq, size_t size)
 {
-	node_t *root = huffman_tree(data, freq, size);
-	if (!root) return (0);
-	print_leaf_data(NULL, root);
+	char code[HUFFMAN_ALPHABET_MAX];
+	node_t *root;
+
+	if (size > HUFFMAN_ALPHABET_MAX)
+		return (0);
+	root = huffman_tree(data, freq, size);
+	if (!root)
+		return (0);
+	print_leaf_data(code, 0, root);
 	free_binary_tree_node(root, free);
 	return (1);
 }
@@ -0,0 +1,375 @@
+#include "huffman.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TABLE_BITS	HUFFMAN_LOOKUP_BITS
+#define TABLE_SIZE	(1 << TABLE_BITS)
+
+/**
+ * struct bit_reader_s - Least significant bit first bit reader
+ *
+ * @acc: Bits not consumed yet, the next one in the low end
+ * @nbits: Amount of valid bits in @acc
+ * @in: Bit stream
+ * @pos: Index in @in of the next byte to load; may run past @len, the
+ * bytes past the end reading as zeros
+ * @len: Length of @in
+ */
+typedef struct bit_reader_s
+{
+	uint64_t acc;
+	unsigned int nbits;
+	const uint8_t *in;
+	size_t pos;
+	size_t len;
+} bit_reader_t;
+
+/**
+ * load_le64 - loads a 64-bit little-endian word
+ * @p: source, any alignment
+ * Return: the word
+ */
+static uint64_t load_le64(const uint8_t *p)
+{
+	uint64_t v;
+
+	memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	return (v);
+}
+
+/**
+ * bit_refill - tops the accumulator up to at least 56 bits: away from the
+ * end of the stream with a single 64-bit load, and no loop or branch per
+ * byte; near the end one byte at a time
+ * @r: bit reader
+ */
+static inline void bit_refill(bit_reader_t *r)
+{
+	if (r->pos + 8 <= r->len)
+	{
+		r->acc |= load_le64(r->in + r->pos) << r->nbits;
+		r->pos += (63 - r->nbits) >> 3;
+		r->nbits |= 56;
+		return;
+	}
+	for (; r->nbits <= 56; r->nbits += 8, r->pos++)
+		if (r->pos < r->len)
+			r->acc |= (uint64_t)r->in[r->pos] << r->nbits;
+}
+
+/**
+ * table_fill - stores an entry at every index of a table whose low bits
+ * match a code
+ * @t: table
+ * @bits: amount of bits indexing @t
+ * @code: code, its first bit in the low end
+ * @len: length of @code
+ * @e: entry to store
+ * Return: 1 on success, 0 if the code overlaps a secondary table link,
+ * which only a corrupt header can cause
+ */
+static int table_fill(huffman_entry_t *t, unsigned int bits, uint32_t code,
+		      unsigned int len, huffman_entry_t e)
+{
+	uint32_t i;
+
+	for (i = 0; i < (1U << (bits - len)); i++)
+	{
+		if (t[code | (i << len)].sub)
+			return (0);
+		t[code | (i << len)] = e;
+	}
+	return (1);
+}
+
+/**
+ * huffman_lookup_build - builds the decoding table of a code: codes of up
+ * to HUFFMAN_LOOKUP_BITS bits resolve in the primary table, and longer ones
+ * through one secondary table per primary index, just large enough for the
+ * longest code sharing that prefix
+ * @nsym: size_t amount of coded symbols
+ * @sym: symbols
+ * @len: code lengths, from 1 to HUFFMAN_MAX_BITS
+ * @code: codes, first bit in the low end
+ * @stack: HUFFMAN_LOOKUP_STACK entries the table may use
+ * @table: receives a pointer to the table, @stack or allocated (the caller
+ * frees it if it is not @stack)
+ * Return: int 1 on success, 0 on failure
+ */
+int huffman_lookup_build(size_t nsym, const uint16_t *sym,
+			 const unsigned char *len, const uint32_t *code,
+			 huffman_entry_t *stack, huffman_entry_t **table)
+{
+	unsigned char sub[TABLE_SIZE] = {0};
+	size_t i, total = TABLE_SIZE, p;
+	huffman_entry_t *t, e;
+	int ok = 1;
+
+	for (i = 0; i < nsym; i++)
+	{
+		p = code[i] & (TABLE_SIZE - 1);
+		if (len[i] > TABLE_BITS && len[i] - TABLE_BITS > sub[p])
+			sub[p] = len[i] - TABLE_BITS;
+	}
+	for (p = 0; p < TABLE_SIZE; p++)
+		total += sub[p] ? (size_t)1 << sub[p] : 0;
+	t = total <= HUFFMAN_LOOKUP_STACK ? stack :
+		malloc(sizeof(*t) * total);
+	if (!t)
+		return (0);
+	memset(t, 0, sizeof(*t) * total);
+	for (p = 0, total = TABLE_SIZE; p < TABLE_SIZE; p++)
+	{
+		if (!sub[p])
+			continue;
+		t[p].value = (uint32_t)total;
+		t[p].length = TABLE_BITS;
+		t[p].sub = sub[p];
+		total += (size_t)1 << sub[p];
+	}
+	/* links are all in place: long codes first, short ones may not */
+	/* land on them */
+	for (i = 0; i < nsym; i++)
+	{
+		if (len[i] <= TABLE_BITS)
+			continue;
+		p = code[i] & (TABLE_SIZE - 1);
+		e.value = sym[i];
+		e.length = len[i];
+		e.sub = 0;
+		ok &= table_fill(t + t[p].value, t[p].sub,
+				 code[i] >> TABLE_BITS, len[i] - TABLE_BITS, e);
+	}
+	for (i = 0; ok && i < nsym; i++)
+	{
+		if (len[i] > TABLE_BITS)
+			continue;
+		e.value = sym[i];
+		e.length = len[i];
+		e.sub = 0;
+		ok = table_fill(t, TABLE_BITS, code[i], len[i], e);
+	}
+	if (!ok && t != stack)
+		free(t);
+	*table = ok ? t : NULL;
+	return (ok);
+}
+
+/**
+ * decode_symbol - decodes one byte
+ * @t: decoding table
+ * @r: bit reader, refilled with enough bits for the symbol
+ * @out: receives the byte
+ * Return: unsigned int bits consumed, 0 if the code does not exist
+ */
+static inline unsigned int decode_symbol(const huffman_entry_t *t,
+					 bit_reader_t *r, uint8_t *out)
+{
+	huffman_entry_t e = huffman_lookup(t, r->acc);
+
+	r->acc >>= e.length;
+	r->nbits -= e.length;
+	*out = (uint8_t)e.value;
+	return (e.length);
+}
+
+/**
+ * bit_check - checks that a reader did not consume more bits, padding
+ * included, than its stream holds
+ * @r: bit reader
+ * Return: 1 if it did not, 0 if the stream was too short
+ */
+static int bit_check(const bit_reader_t *r)
+{
+	return (r->pos * 8 - r->nbits <= r->len * 8);
+}
+
+/**
+ * decode_stream - decodes a bit stream, refilling the reader once for as
+ * many symbols as are sure to fit in 56 bits
+ * @t: decoding table
+ * @max_len: length of the longest code
+ * @r: bit reader over the stream
+ * @out: output buffer
+ * @n: amount of symbols to decode
+ * Return: 1 on success, 0 if the stream is corrupt or too short
+ */
+static int decode_stream(const huffman_entry_t *t, unsigned int max_len,
+			 bit_reader_t *r, uint8_t *out, size_t n)
+{
+	size_t i = 0, k, per = 56 / max_len;
+
+	while (i < n)
+	{
+		bit_refill(r);
+		for (k = 0; k < per && i < n; k++, i++)
+			if (!decode_symbol(t, r, out + i))
+				return (0);
+	}
+	return (bit_check(r));
+}
+
+/**
+ * decode_streams - decodes the HUFFMAN_STREAMS bit streams of a huff4
+ * block in lockstep: the streams are independent, so each step of the
+ * loop is four dependency chains an out-of-order core runs side by side
+ * rather than one; the first streams, a few symbols longer than the last,
+ * are then finished one at a time
+ * @t: decoding table
+ * @max_len: length of the longest code
+ * @r: HUFFMAN_STREAMS bit readers, one per stream
+ * @out: output buffer
+ * @n: amount of symbols to decode
+ * Return: 1 on success, 0 if a stream is corrupt or too short
+ */
+static int decode_streams(const huffman_entry_t *t, unsigned int max_len,
+			  bit_reader_t *r, uint8_t *out, size_t n)
+{
+	size_t q = (n + HUFFMAN_STREAMS - 1) / HUFFMAN_STREAMS;
+	size_t last = n - (HUFFMAN_STREAMS - 1) * q, i = 0, k;
+	size_t per = 56 / max_len;
+	uint8_t *o1 = out + q, *o2 = out + 2 * q, *o3 = out + 3 * q;
+	unsigned int ok = 1, j;
+
+	while (i < last && ok)
+	{
+		bit_refill(&r[0]);
+		bit_refill(&r[1]);
+		bit_refill(&r[2]);
+		bit_refill(&r[3]);
+		for (k = 0; k < per && i < last; k++, i++)
+		{
+			ok &= decode_symbol(t, &r[0], out + i) != 0;
+			ok &= decode_symbol(t, &r[1], o1 + i) != 0;
+			ok &= decode_symbol(t, &r[2], o2 + i) != 0;
+			ok &= decode_symbol(t, &r[3], o3 + i) != 0;
+		}
+	}
+	for (j = 0; ok && j < HUFFMAN_STREAMS - 1; j++)
+		ok = decode_stream(t, max_len, &r[j], out + j * q + last,
+				   q - last);
+	return (ok && bit_check(&r[3]));
+}
+
+/**
+ * streams_open - sets up the bit readers of a huff4 block from its jump
+ * table
+ * @in: jump table, followed by the streams
+ * @n: size_t length of @in
+ * @size: size_t decoded length of the block
+ * @r: HUFFMAN_STREAMS bit readers to set up, zeroed
+ * Return: 1 on success, 0 if the jump table is corrupt
+ */
+static int streams_open(const uint8_t *in, size_t n, size_t size,
+			bit_reader_t *r)
+{
+	size_t q = (size + HUFFMAN_STREAMS - 1) / HUFFMAN_STREAMS, len;
+	unsigned int i;
+
+	if (n < HUFFMAN_JUMP_TABLE || q * (HUFFMAN_STREAMS - 1) > size)
+		return (0);
+	r[0].in = in + HUFFMAN_JUMP_TABLE;
+	n -= HUFFMAN_JUMP_TABLE;
+	for (i = 0; i < HUFFMAN_STREAMS - 1; i++)
+	{
+		len = (size_t)in[4 * i] | (size_t)in[4 * i + 1] << 8 |
+			(size_t)in[4 * i + 2] << 16 |
+			(size_t)in[4 * i + 3] << 24;
+		if (len > n)
+			return (0);
+		r[i].len = len;
+		r[i + 1].in = r[i].in + len;
+		n -= len;
+	}
+	r[i].len = n;
+	return (1);
+}
+
+/**
+ * huffman_decoded_size - reads the decoded length of a block
+ * @in: encoded block
+ * @n: size_t length of @in
+ * Return: size_t decoded length, or HUFFMAN_ERROR if @in is not a block
+ */
+size_t huffman_decoded_size(const uint8_t *in, size_t n)
+{
+	uint64_t size;
+
+	if (!in || n < HUFFMAN_HEADER ||
+	    in[0] > HUFFMAN_MODE_HUFF4)
+		return (HUFFMAN_ERROR);
+	size = load_le64(in + 1);
+	if (size >= HUFFMAN_ERROR)
+		return (HUFFMAN_ERROR);
+	return ((size_t)size);
+}
+
+/**
+ * huffman_decode - decompresses a block written by huffman_encode(), with
+ * a table lookup per symbol instead of a tree walk per bit
+ * @in: encoded block
+ * @n: size_t length of @in
+ * @out: output buffer
+ * @cap: size_t length of @out, at least huffman_decoded_size(@in, @n)
+ * Return: size_t amount of bytes decoded, or HUFFMAN_ERROR on failure
+ */
+size_t huffman_decode(const uint8_t *in, size_t n, uint8_t *out, size_t cap)
+{
+	uint16_t sym[HUFFMAN_SYMBOLS];
+	unsigned char len[HUFFMAN_SYMBOLS], lengths[HUFFMAN_SYMBOLS];
+	uint32_t code[HUFFMAN_SYMBOLS];
+	huffman_code_t codes[HUFFMAN_SYMBOLS];
+	huffman_entry_t stack[HUFFMAN_LOOKUP_STACK], *t = NULL;
+	size_t size = huffman_decoded_size(in, n), nsym = 0, hsize, i;
+	unsigned int max_len = 1;
+	bit_reader_t r[HUFFMAN_STREAMS] = {{0, 0, NULL, 0, 0}};
+	int ok;
+
+	if (size == HUFFMAN_ERROR || size > cap || (size && !out))
+		return (HUFFMAN_ERROR);
+	if (in[0] == HUFFMAN_MODE_RAW)
+	{
+		if (n - HUFFMAN_HEADER < size)
+			return (HUFFMAN_ERROR);
+		if (size)
+			memcpy(out, in + HUFFMAN_HEADER, size);
+		return (size);
+	}
+
+	/* rebuild the canonical codes from the lengths in the header */
+	hsize = huffman_lengths_read(in + HUFFMAN_HEADER, n - HUFFMAN_HEADER,
+				     HUFFMAN_SYMBOLS, lengths);
+	if (!hsize || !huffman_canonical_codes(lengths, HUFFMAN_SYMBOLS, codes))
+		return (HUFFMAN_ERROR);
+	for (i = 0; i < HUFFMAN_SYMBOLS; i++)
+	{
+		if (!codes[i].length)
+			continue;
+		sym[nsym] = (uint16_t)i;
+		len[nsym] = codes[i].length;
+		code[nsym++] = codes[i].bits;
+		if (codes[i].length > max_len)
+			max_len = codes[i].length;
+	}
+	if (!nsym || !huffman_lookup_build(nsym, sym, len, code, stack,
+					   &t))
+		return (HUFFMAN_ERROR);
+
+	hsize += HUFFMAN_HEADER;
+	if (in[0] == HUFFMAN_MODE_HUFF)
+	{
+		r[0].in = in + hsize;
+		r[0].len = n - hsize;
+		ok = decode_stream(t, max_len, &r[0], out, size);
+	}
+	else
+		ok = streams_open(in + hsize, n - hsize, size, r) &&
+			decode_streams(t, max_len, r, out, size);
+	if (t != stack)
+		free(t);
+
+	return (ok ? size : HUFFMAN_ERROR);
+}
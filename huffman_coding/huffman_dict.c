@@ -0,0 +1,279 @@
+#include "huffman.h"
+#include <string.h>
+
+#define DICT_SIZE	(1 << HUFFMAN_DICT_BITS)
+#define ENTRY_SHIFT	9
+#define LITERAL_BITS	8
+/* longest varint of a 64-bit value */
+#define VARINT_MAX	10
+
+/**
+ * dict_setup - derives the canonical codes and the decoding table of a
+ * shared table from its code lengths
+ * @dict: table, lengths filled in
+ * Return: int 1 on success, 0 if the lengths are not a usable code
+ */
+static int dict_setup(huffman_dict_t *dict)
+{
+	size_t i, k, coded = 0;
+	unsigned int len;
+
+	for (i = 0; i <= HUFFMAN_DICT_ESCAPE; i++)
+	{
+		if (dict->lengths[i] > HUFFMAN_DICT_BITS)
+			return (0);
+		coded += dict->lengths[i] != 0;
+	}
+	if (!coded || !huffman_canonical_codes(dict->lengths,
+					       HUFFMAN_SYMBOLS + 1,
+					       dict->codes))
+		return (0);
+	memset(dict->decode, 0, sizeof(dict->decode));
+	for (i = 0; i <= HUFFMAN_DICT_ESCAPE; i++)
+	{
+		len = dict->lengths[i];
+		if (!len)
+			continue;
+		for (k = 0; k < (size_t)1 << (HUFFMAN_DICT_BITS - len); k++)
+			dict->decode[dict->codes[i].bits | k << len] =
+				(uint16_t)(len << ENTRY_SHIFT | i);
+	}
+	return (1);
+}
+
+/**
+ * huffman_dict_train - builds a shared code table from sample messages, so
+ * that messages like them can be coded without a table of their own
+ * @samples: sample messages, one after the other
+ * @n: size_t length of @samples
+ * @escape: if not 0, bytes missing from @samples get an escape code, and
+ * any message can be coded; otherwise only messages made of bytes found in
+ * @samples are coded, others being stored raw
+ * @dict: receives the table
+ * Return: int 1 on success, 0 on failure
+ */
+int huffman_dict_train(const uint8_t *samples, size_t n, int escape,
+		       huffman_dict_t *dict)
+{
+	size_t freq[HUFFMAN_SYMBOLS + 1];
+
+	if (!dict || (!samples && n))
+		return (0);
+	if (!n)
+		memset(freq, 0, sizeof(freq));
+	else if (!huffman_histogram(samples, n, freq))
+		return (0);
+	freq[HUFFMAN_DICT_ESCAPE] = escape ? 1 : 0;
+	if (!huffman_code_lengths_limited(freq, HUFFMAN_SYMBOLS + 1,
+					  dict->lengths, HUFFMAN_DICT_BITS))
+		return (0);
+	return (dict_setup(dict));
+}
+
+/**
+ * huffman_dict_save - serializes a shared code table
+ * @dict: table
+ * @out: receives at most HUFFMAN_DICT_SAVE_MAX bytes
+ * Return: size_t amount of bytes written, 0 on failure
+ */
+size_t huffman_dict_save(const huffman_dict_t *dict, uint8_t *out)
+{
+	if (!dict || !out)
+		return (0);
+	memcpy(out, HUFFMAN_DICT_MAGIC, 4);
+	out[4] = dict->lengths[HUFFMAN_DICT_ESCAPE];
+	return (5 + huffman_lengths_write(dict->lengths, HUFFMAN_SYMBOLS,
+					   out + 5));
+}
+
+/**
+ * huffman_dict_load - loads a table serialized by huffman_dict_save(),
+ * building its codes and decoding table once for all the messages to come
+ * @in: serialized table
+ * @n: size_t length of @in
+ * @dict: receives the table
+ * Return: size_t amount of bytes read, 0 if @in is not a valid table
+ */
+size_t huffman_dict_load(const uint8_t *in, size_t n, huffman_dict_t *dict)
+{
+	size_t size;
+
+	if (!in || !dict || n < 5 || memcmp(in, HUFFMAN_DICT_MAGIC, 4))
+		return (0);
+	dict->lengths[HUFFMAN_DICT_ESCAPE] = in[4];
+	size = huffman_lengths_read(in + 5, n - 5, HUFFMAN_SYMBOLS,
+				    dict->lengths);
+	if (!size || !dict_setup(dict))
+		return (0);
+	return (5 + size);
+}
+
+/**
+ * huffman_dict_bound - worst case size of a message coded with a shared
+ * table, reached when it is stored raw
+ * @n: size_t length of the message
+ * Return: size_t amount of bytes huffman_dict_encode() may need
+ */
+size_t huffman_dict_bound(size_t n)
+{
+	return (VARINT_MAX + n);
+}
+
+/**
+ * varint_put - writes a little-endian base-128 varint
+ * @out: output buffer, VARINT_MAX bytes are always enough
+ * @v: value
+ * Return: size_t amount of bytes written
+ */
+static size_t varint_put(uint8_t *out, uint64_t v)
+{
+	size_t i = 0;
+
+	for (; v >= 0x80; v >>= 7)
+		out[i++] = (uint8_t)(v | 0x80);
+	out[i++] = (uint8_t)v;
+	return (i);
+}
+
+/**
+ * varint_get - reads a little-endian base-128 varint
+ * @in: input
+ * @n: size_t length of @in
+ * @v: receives the value
+ * Return: size_t amount of bytes read, 0 if @in holds no valid varint
+ */
+static size_t varint_get(const uint8_t *in, size_t n, uint64_t *v)
+{
+	size_t i;
+
+	*v = 0;
+	for (i = 0; i < n && i < VARINT_MAX; i++)
+	{
+		*v |= (uint64_t)(in[i] & 0x7f) << (7 * i);
+		if (!(in[i] & 0x80))
+			return (i + 1);
+	}
+	return (0);
+}
+
+/**
+ * huffman_dict_encode - codes a message with a shared table, the codes
+ * going out through a 64-bit accumulator, a byte at a time; the message is
+ * stored raw when coding would not make it smaller, or when it holds a
+ * byte the table has no code for
+ * @dict: table
+ * @in: message
+ * @n: size_t length of @in
+ * @out: output buffer, huffman_dict_bound(@n) bytes are always enough
+ * @cap: size_t length of @out
+ * Return: size_t amount of bytes written, 0 on failure
+ */
+size_t huffman_dict_encode(const huffman_dict_t *dict, const uint8_t *in,
+			   size_t n, uint8_t *out, size_t cap)
+{
+	const huffman_code_t *esc;
+	uint8_t head[VARINT_MAX];
+	size_t bits = 0, hsize, i;
+	uint64_t acc = 0;
+	unsigned int nbits = 0;
+
+	if (!dict || (!in && n) || !out)
+		return (0);
+	esc = &dict->codes[HUFFMAN_DICT_ESCAPE];
+	for (i = 0; i < n && bits != HUFFMAN_ERROR; i++)
+		if (dict->codes[in[i]].length)
+			bits += dict->codes[in[i]].length;
+		else
+			bits = esc->length ? bits + esc->length + LITERAL_BITS :
+				HUFFMAN_ERROR;
+	hsize = varint_put(head, (uint64_t)n << 1);
+	if (bits == HUFFMAN_ERROR || (bits + 7) / 8 >= n)
+	{
+		hsize = varint_put(head, (uint64_t)n << 1 | 1);
+		if (cap < hsize + n)
+			return (0);
+		memcpy(out, head, hsize);
+		if (n)
+			memcpy(out + hsize, in, n);
+		return (hsize + n);
+	}
+	if (cap < hsize + (bits + 7) / 8)
+		return (0);
+	memcpy(out, head, hsize);
+	out += hsize;
+	for (i = 0; i < n; i++)
+	{
+		if (dict->codes[in[i]].length)
+		{
+			acc |= (uint64_t)dict->codes[in[i]].bits << nbits;
+			nbits += dict->codes[in[i]].length;
+		}
+		else
+		{
+			acc |= ((uint64_t)esc->bits |
+				(uint64_t)in[i] << esc->length) << nbits;
+			nbits += esc->length + LITERAL_BITS;
+		}
+		for (; nbits >= 8; nbits -= 8, acc >>= 8)
+			*out++ = (uint8_t)acc;
+	}
+	if (nbits)
+		*out = (uint8_t)acc;
+	return (hsize + (bits + 7) / 8);
+}
+
+/**
+ * huffman_dict_decode - decodes a message coded by huffman_dict_encode()
+ * with the same table, one table lookup per symbol
+ * @dict: table
+ * @in: coded message
+ * @n: size_t length of @in
+ * @out: output buffer
+ * @cap: size_t length of @out, at least the length of the message
+ * Return: size_t length of the message, or HUFFMAN_ERROR on failure
+ */
+size_t huffman_dict_decode(const huffman_dict_t *dict, const uint8_t *in,
+			   size_t n, uint8_t *out, size_t cap)
+{
+	size_t hsize, size, pos, i;
+	uint64_t head, acc = 0;
+	unsigned int nbits = 0, e, len;
+
+	if (!dict || !in)
+		return (HUFFMAN_ERROR);
+	hsize = varint_get(in, n, &head);
+	size = (size_t)(head >> 1);
+	if (!hsize || (head >> 1) > cap || (size && !out))
+		return (HUFFMAN_ERROR);
+	in += hsize;
+	n -= hsize;
+	if (head & 1)
+	{
+		if (n < size)
+			return (HUFFMAN_ERROR);
+		if (size)
+			memcpy(out, in, size);
+		return (size);
+	}
+	for (i = 0, pos = 0; i < size; i++)
+	{
+		/* bytes past the end read as zeros, caught below */
+		for (; nbits <= 56; nbits += 8, pos++)
+			acc |= (uint64_t)(pos < n ? in[pos] : 0) << nbits;
+		e = dict->decode[acc & (DICT_SIZE - 1)];
+		len = e >> ENTRY_SHIFT;
+		if (!len)
+			return (HUFFMAN_ERROR);
+		acc >>= len;
+		nbits -= len;
+		e &= (1U << ENTRY_SHIFT) - 1;
+		if (e == HUFFMAN_DICT_ESCAPE)
+		{
+			e = acc & 0xff;
+			acc >>= LITERAL_BITS;
+			nbits -= LITERAL_BITS;
+		}
+		out[i] = (uint8_t)e;
+	}
+	return (pos * 8 - nbits <= n * 8 ? size : HUFFMAN_ERROR);
+}
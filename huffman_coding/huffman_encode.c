@@ -0,0 +1,284 @@
+#include "huffman.h"
+#include <string.h>
+
+/**
+ * struct bit_writer_s - Least significant bit first bit writer
+ *
+ * @acc: Pending bits, the oldest in the low end
+ * @nbits: Amount of pending bits, below 32 between two writes
+ * @out: Where the next whole word goes
+ */
+typedef struct bit_writer_s
+{
+	uint64_t acc;
+	unsigned int nbits;
+	uint8_t *out;
+} bit_writer_t;
+
+/**
+ * store_le32 - stores a 32-bit word in little-endian byte order
+ * @p: destination, any alignment
+ * @v: word
+ */
+static void store_le32(uint8_t *p, uint32_t v)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap32(v);
+#endif
+	memcpy(p, &v, sizeof(v));
+}
+
+/**
+ * store_le64 - stores a 64-bit word in little-endian byte order
+ * @p: destination, any alignment
+ * @v: word
+ */
+static void store_le64(uint8_t *p, uint64_t v)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	memcpy(p, &v, sizeof(v));
+}
+
+/**
+ * bit_put - appends a code to the bit stream; the accumulator has room for
+ * a whole code since at most 31 bits are pending, and is flushed one 32-bit
+ * word at a time, with no branch per bit
+ * @w: bit writer
+ * @code: code of the symbol
+ */
+static inline void bit_put(bit_writer_t *w, huffman_code_t code)
+{
+	w->acc |= (uint64_t)code.bits << w->nbits;
+	w->nbits += code.length;
+	if (w->nbits >= 32)
+	{
+		store_le32(w->out, (uint32_t)w->acc);
+		w->out += 4;
+		w->acc >>= 32;
+		w->nbits -= 32;
+	}
+}
+
+/**
+ * bit_flush - writes the bits still pending, zero-padded to a whole byte
+ * @w: bit writer
+ * Return: pointer one past the last byte written
+ */
+static uint8_t *bit_flush(bit_writer_t *w)
+{
+	for (; w->nbits > 0; w->nbits -= w->nbits < 8 ? w->nbits : 8)
+	{
+		*w->out++ = (uint8_t)w->acc;
+		w->acc >>= 8;
+	}
+	return (w->out);
+}
+
+/**
+ * huffman_encode_bound - worst case size of an encoded block, reached when
+ * it is stored raw
+ * @n: size_t length of the input
+ * Return: size_t amount of output bytes huffman_encode() may need
+ */
+size_t huffman_encode_bound(size_t n)
+{
+	return (HUFFMAN_HEADER + n);
+}
+
+/**
+ * encode_raw - stores a block as is
+ * @in: input bytes
+ * @n: size_t length of @in
+ * @out: output buffer
+ * @cap: size_t length of @out
+ * Return: size_t amount of bytes written, 0 if @out is too small
+ */
+static size_t encode_raw(const uint8_t *in, size_t n, uint8_t *out,
+			 size_t cap)
+{
+	if (cap < HUFFMAN_HEADER + n)
+		return (0);
+	out[0] = HUFFMAN_MODE_RAW;
+	store_le64(out + 1, n);
+	if (n)
+		memcpy(out + HUFFMAN_HEADER, in, n);
+	return (HUFFMAN_HEADER + n);
+}
+
+/**
+ * encode_stream - writes the bit stream of a run of symbols
+ * @table: code of each symbol
+ * @in: symbols
+ * @n: size_t amount of symbols
+ * @out: output buffer, large enough for the stream
+ * Return: pointer one past the last byte written
+ */
+static uint8_t *encode_stream(const huffman_code_t *table, const uint8_t *in,
+			      size_t n, uint8_t *out)
+{
+	bit_writer_t w = {0, 0, NULL};
+	size_t i;
+
+	w.out = out;
+	for (i = 0; i < n; i++)
+		bit_put(&w, table[in[i]]);
+	return (bit_flush(&w));
+}
+
+/**
+ * stream_bits - size of the bit stream of a run of symbols
+ * @table: code of each symbol
+ * @in: symbols
+ * @n: size_t amount of symbols
+ * Return: size_t amount of bits of the codes of @in
+ */
+static size_t stream_bits(const huffman_code_t *table, const uint8_t *in,
+			  size_t n)
+{
+	size_t bits = 0, i;
+
+	for (i = 0; i < n; i++)
+		bits += table[in[i]].length;
+	return (bits);
+}
+
+/**
+ * encode_streams - writes the jump table and the HUFFMAN_STREAMS bit
+ * streams of a huff4 block, which decode independently of one another
+ * @table: code of each symbol
+ * @in: input bytes
+ * @n: size_t length of @in
+ * @out: output buffer, past the code lengths
+ * @cap: size_t length of @out
+ * @bits: size_t amount of bits of all the codes of @in
+ * Return: size_t amount of bytes written, 0 if @out is too small
+ */
+static size_t encode_streams(const huffman_code_t *table, const uint8_t *in,
+			     size_t n, uint8_t *out, size_t cap, size_t bits)
+{
+	size_t q = (n + HUFFMAN_STREAMS - 1) / HUFFMAN_STREAMS, b;
+	size_t total = HUFFMAN_JUMP_TABLE;
+	uint8_t *p = out + HUFFMAN_JUMP_TABLE;
+	unsigned int i;
+
+	for (i = 0; i < HUFFMAN_STREAMS - 1; i++)
+	{
+		b = stream_bits(table, in + i * q, q);
+		bits -= b;
+		total += (b + 7) / 8;
+		store_le32(out + 4 * i, (uint32_t)((b + 7) / 8));
+	}
+	total += (bits + 7) / 8;
+	if (total > cap)
+		return (0);
+	for (i = 0; i < HUFFMAN_STREAMS; i++)
+		p = encode_stream(table, in + i * q,
+				  i < HUFFMAN_STREAMS - 1 ? q : n - i * q, p);
+	return ((size_t)(p - out));
+}
+
+/**
+ * worth_coding - tells from the histogram alone whether coding a block can
+ * save at least 1 / HUFFMAN_MIN_GAIN of its size, so that already
+ * compressed or encrypted data is stored raw without building a code: the
+ * estimate is the entropy of the counts, at least a bit per symbol, plus
+ * a nibble of code length header per symbol used
+ * @freq: count of each byte value
+ * @n: size_t length of the block
+ * Return: int 1 if coding looks worthwhile, 0 otherwise
+ */
+static int worth_coding(const size_t *freq, size_t n)
+{
+	size_t bits = huffman_entropy_bits(freq, HUFFMAN_SYMBOLS), used = 0, i;
+
+	for (i = 0; i < HUFFMAN_SYMBOLS; i++)
+		used += freq[i] != 0;
+	if (bits < n)
+		bits = n;
+	return (bits / 8 + used / 2 + n / HUFFMAN_MIN_GAIN < n);
+}
+
+/**
+ * huffman_encode_params - compresses a buffer into one Huffman coded block
+ * (see huffman.h for the format): symbols are counted, code lengths
+ * computed with huffman_code_lengths_limited() and turned into a flat table
+ * of canonical codes, and the input is then written through a 64-bit bit
+ * accumulator, as one bit stream or as HUFFMAN_STREAMS the decoder can
+ * work through side by side. The block is stored raw instead when coding
+ * would not make it smaller, which the entropy of the counts tells before
+ * any code is built for most incompressible data.
+ * @in: input bytes
+ * @n: size_t length of @in
+ * @out: output buffer, huffman_encode_bound(@n) bytes are always enough
+ * @cap: size_t length of @out
+ * @params: encoding options, or NULL for the defaults
+ * Return: size_t amount of bytes written, 0 on failure
+ */
+size_t huffman_encode_params(const uint8_t *in, size_t n, uint8_t *out,
+			     size_t cap, const huffman_params_t *params)
+{
+	size_t freq[HUFFMAN_SYMBOLS], bits = 0, size, i, hsize, limit;
+	unsigned char lengths[HUFFMAN_SYMBOLS];
+	uint8_t header[HUFFMAN_LENGTHS_MAX];
+	huffman_code_t table[HUFFMAN_SYMBOLS];
+	unsigned int max = HUFFMAN_DEFAULT_MAX_BITS;
+	unsigned int streams = n >= HUFFMAN_STREAMS_MIN ? HUFFMAN_STREAMS : 1;
+
+	if ((!in && n) || !out)
+		return (0);
+	if (params && params->max_code_length)
+		max = params->max_code_length;
+	if (params && params->streams)
+		streams = params->streams;
+	if (max > HUFFMAN_MAX_BITS ||
+	    (streams != 1 && streams != HUFFMAN_STREAMS))
+		return (0);
+	/* the first streams must fit in the block, and their byte lengths in */
+	/* the 32-bit entries of the jump table */
+	if (n < 2 * HUFFMAN_STREAMS || n > (size_t)1 << 30)
+		streams = 1;
+	if (!n || !huffman_histogram(in, n, freq) || !worth_coding(freq, n) ||
+	    !huffman_code_lengths_limited(freq, HUFFMAN_SYMBOLS, lengths,
+					  max) ||
+	    !huffman_canonical_codes(lengths, HUFFMAN_SYMBOLS, table))
+		return (encode_raw(in, n, out, cap));
+
+	for (i = 0; i < HUFFMAN_SYMBOLS; i++)
+		bits += freq[i] * lengths[i];
+	hsize = huffman_lengths_write(lengths, HUFFMAN_SYMBOLS, header);
+	size = HUFFMAN_HEADER + hsize + (bits + 7) / 8;
+	if (streams > 1)
+		size += HUFFMAN_JUMP_TABLE;
+	if (size >= HUFFMAN_HEADER + n || size > cap)
+		return (encode_raw(in, n, out, cap));
+
+	out[0] = streams > 1 ? HUFFMAN_MODE_HUFF4 : HUFFMAN_MODE_HUFF;
+	store_le64(out + 1, n);
+	memcpy(out + HUFFMAN_HEADER, header, hsize);
+	size = HUFFMAN_HEADER + hsize;
+	if (streams == 1)
+		return ((size_t)(encode_stream(table, in, n, out + size) -
+				 out));
+	/* the padding of each stream may tip it over the raw size */
+	limit = (cap < HUFFMAN_HEADER + n ? cap : HUFFMAN_HEADER + n) - size;
+	i = encode_streams(table, in, n, out + size, limit, bits);
+	if (!i)
+		return (encode_raw(in, n, out, cap));
+	return (size + i);
+}
+
+/**
+ * huffman_encode - compresses a buffer into one Huffman coded block, with
+ * codes of at most HUFFMAN_DEFAULT_MAX_BITS bits
+ * @in: input bytes
+ * @n: size_t length of @in
+ * @out: output buffer, huffman_encode_bound(@n) bytes are always enough
+ * @cap: size_t length of @out
+ * Return: size_t amount of bytes written, 0 on failure
+ */
+size_t huffman_encode(const uint8_t *in, size_t n, uint8_t *out, size_t cap)
+{
+	return (huffman_encode_params(in, n, out, cap, NULL));
+}
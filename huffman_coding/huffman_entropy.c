@@ -0,0 +1,93 @@
+#include "huffman.h"
+
+/* fractional bits of the fixed-point logarithms */
+#define LOG_SHIFT	16
+/* mantissa bits indexing the table */
+#define LOG_BITS	8
+
+/* log2(1 + i / 256) in 16.16 fixed point */
+static const uint16_t log2_table[1 << LOG_BITS] = {
+	0, 369, 736, 1102, 1466, 1829, 2190, 2551,
+	2909, 3267, 3623, 3978, 4331, 4683, 5034, 5384,
+	5732, 6079, 6425, 6769, 7112, 7454, 7795, 8134,
+	8473, 8810, 9146, 9480, 9814, 10146, 10477, 10807,
+	11136, 11464, 11791, 12116, 12440, 12764, 13086, 13407,
+	13727, 14046, 14363, 14680, 14996, 15310, 15624, 15937,
+	16248, 16559, 16868, 17177, 17484, 17791, 18096, 18401,
+	18704, 19007, 19308, 19609, 19909, 20207, 20505, 20802,
+	21098, 21393, 21687, 21980, 22272, 22564, 22854, 23144,
+	23433, 23720, 24007, 24293, 24579, 24863, 25146, 25429,
+	25711, 25992, 26272, 26551, 26830, 27108, 27384, 27660,
+	27936, 28210, 28484, 28757, 29029, 29300, 29571, 29840,
+	30109, 30378, 30645, 30912, 31178, 31443, 31707, 31971,
+	32234, 32496, 32758, 33019, 33279, 33538, 33797, 34055,
+	34312, 34569, 34825, 35080, 35334, 35588, 35841, 36094,
+	36346, 36597, 36847, 37097, 37346, 37595, 37842, 38090,
+	38336, 38582, 38827, 39072, 39316, 39559, 39802, 40044,
+	40286, 40527, 40767, 41006, 41246, 41484, 41722, 41959,
+	42196, 42432, 42667, 42902, 43137, 43370, 43603, 43836,
+	44068, 44300, 44530, 44761, 44990, 45220, 45448, 45676,
+	45904, 46131, 46357, 46583, 46809, 47034, 47258, 47482,
+	47705, 47928, 48150, 48372, 48593, 48813, 49034, 49253,
+	49472, 49691, 49909, 50127, 50344, 50560, 50776, 50992,
+	51207, 51422, 51636, 51850, 52063, 52276, 52488, 52700,
+	52911, 53122, 53332, 53542, 53751, 53960, 54169, 54377,
+	54584, 54791, 54998, 55204, 55410, 55615, 55820, 56025,
+	56229, 56432, 56635, 56838, 57040, 57242, 57443, 57644,
+	57845, 58045, 58245, 58444, 58643, 58841, 59039, 59237,
+	59434, 59631, 59827, 60023, 60219, 60414, 60609, 60803,
+	60997, 61190, 61384, 61576, 61769, 61961, 62152, 62343,
+	62534, 62725, 62915, 63104, 63294, 63483, 63671, 63859,
+	64047, 64234, 64421, 64608, 64794, 64980, 65166, 65351
+};
+
+/**
+ * log2_fixed - base 2 logarithm of an integer in 16.16 fixed point: the
+ * position of its highest bit, plus the table entry of the 8 bits below
+ * @x: size_t value, at least 1
+ * Return: uint64_t log2(@x), accurate to about 0.006
+ */
+static uint64_t log2_fixed(size_t x)
+{
+	unsigned int e = 0;
+	size_t m;
+
+	while (x >> e > 1)
+		e++;
+	m = e >= LOG_BITS ? x >> (e - LOG_BITS) : x << (LOG_BITS - e);
+	return (((uint64_t)e << LOG_SHIFT) +
+		log2_table[m & ((1 << LOG_BITS) - 1)]);
+}
+
+/**
+ * huffman_entropy_bits - estimates the size of a coded block from its
+ * histogram alone, before any code is built: the Shannon entropy of the
+ * counts, which a Huffman code comes within a bit per symbol of, in fixed
+ * point with no floating point or libm call
+ * @freq: count of each symbol
+ * @size: size_t amount of symbols
+ * Return: size_t estimated amount of bits the symbols code to
+ */
+size_t huffman_entropy_bits(const size_t *freq, size_t size)
+{
+	uint64_t total = 0, bits = 0, frac = 0, lt, d;
+	size_t i;
+
+	for (i = 0; i < size; i++)
+		total += freq[i];
+	if (!total)
+		return (0);
+	lt = log2_fixed((size_t)total);
+	for (i = 0; i < size; i++)
+	{
+		if (!freq[i])
+			continue;
+		/* freq * (log2(total) - log2(freq)): whole bits from the */
+		/* high bits of freq, fixed point from the low ones, so that */
+		/* neither overflows nor is rounded per symbol */
+		d = lt - log2_fixed(freq[i]);
+		bits += (freq[i] >> LOG_SHIFT) * d;
+		frac += (freq[i] & ((1 << LOG_SHIFT) - 1)) * d;
+	}
+	return ((size_t)(bits + (frac >> LOG_SHIFT)));
+}
@@ -12,7 +12,7 @@ int huffman_extract_and_insert(heap_t *priority_queue)
 	symbol_t *sl = (symbol_t *)nl->data;
 	symbol_t *sr = (symbol_t *)nr->data;
 	size_t freq = sl->freq + sr->freq;
-	symbol_t *s = symbol_create(-1, freq);
+	symbol_t *s = symbol_internal(freq);
 	node_t *n = nl->parent = nr->parent = binary_tree_node(NULL, s);
 	n->left = nl;
 	n->right = nr;
@@ -0,0 +1,149 @@
+#include "huffman.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* input released back to the kernel every so many bytes of a mapping */
+#define MAP_RELEASE	((size_t)64 << 20)
+
+/**
+ * fd_read - huffman_read_t over a file descriptor
+ * @ctx: pointer to the file descriptor
+ * @buf: buffer to fill
+ * @n: size_t length of @buf
+ * Return: size_t amount of bytes read, 0 at the end of the file, or
+ * HUFFMAN_ERROR
+ */
+static size_t fd_read(void *ctx, uint8_t *buf, size_t n)
+{
+	ssize_t got;
+
+	do {
+		got = read(*(int *)ctx, buf, n);
+	} while (got < 0 && errno == EINTR);
+	return (got < 0 ? HUFFMAN_ERROR : (size_t)got);
+}
+
+/**
+ * fd_write - huffman_write_t over a file descriptor
+ * @ctx: pointer to the file descriptor
+ * @buf: bytes to write
+ * @n: size_t length of @buf
+ * Return: int 1 if all of @buf was written, 0 on failure
+ */
+static int fd_write(void *ctx, const uint8_t *buf, size_t n)
+{
+	ssize_t put;
+
+	while (n)
+	{
+		put = write(*(int *)ctx, buf, n);
+		if (put < 0 && errno == EINTR)
+			continue;
+		if (put <= 0)
+			return (0);
+		buf += put;
+		n -= (size_t)put;
+	}
+	return (1);
+}
+
+/**
+ * struct map_in_s - Memory-mapped input file
+ *
+ * @map: Mapping of the file
+ * @size: Length of the file
+ * @pos: Amount of bytes read
+ * @released: Amount of bytes given back to the kernel
+ */
+typedef struct map_in_s
+{
+	uint8_t *map;
+	size_t size;
+	size_t pos;
+	size_t released;
+} map_in_t;
+
+/**
+ * map_read - huffman_read_t over a memory-mapped file, releasing the pages
+ * already read every MAP_RELEASE bytes, so that the process does not hold
+ * the whole file however large it is
+ * @ctx: map_in_t
+ * @buf: buffer to fill
+ * @n: size_t length of @buf
+ * Return: size_t amount of bytes read, 0 at the end of the file
+ */
+static size_t map_read(void *ctx, uint8_t *buf, size_t n)
+{
+	map_in_t *in = ctx;
+	size_t page = (size_t)sysconf(_SC_PAGESIZE), end;
+
+	if (n > in->size - in->pos)
+		n = in->size - in->pos;
+	memcpy(buf, in->map + in->pos, n);
+	in->pos += n;
+	end = in->pos / page * page;
+	if (end - in->released >= MAP_RELEASE)
+	{
+		madvise(in->map + in->released, end - in->released,
+			MADV_DONTNEED);
+		in->released = end;
+	}
+	return (n);
+}
+
+/**
+ * huffman_compress_fd - compresses a file into the framed stream format;
+ * regular files are memory-mapped, anything else (pipes, terminals) is
+ * read one block at a time
+ * @in_fd: file descriptor to read from
+ * @out_fd: file descriptor to write the stream to
+ * @params: stream options, or NULL for the defaults
+ * Return: int 1 on success, 0 on failure
+ */
+int huffman_compress_fd(int in_fd, int out_fd, const huffman_params_t *params)
+{
+	struct stat st;
+	map_in_t in = {NULL, 0, 0, 0};
+	void *map;
+	int ok;
+
+	if (!huffman_block_size(params))
+		return (0);
+	if (fstat(in_fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+	    (uint64_t)st.st_size <= (size_t)-1)
+	{
+		map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE,
+			   in_fd, 0);
+		if (map != MAP_FAILED)
+		{
+			in.map = map;
+			in.size = (size_t)st.st_size;
+			madvise(map, in.size, MADV_SEQUENTIAL);
+			ok = huffman_compress_stream(map_read, &in, fd_write,
+						     &out_fd, params);
+			munmap(map, in.size);
+			return (ok);
+		}
+	}
+	return (huffman_compress_stream(fd_read, &in_fd, fd_write, &out_fd,
+					params));
+}
+
+/**
+ * huffman_decompress_fd - decompresses a stream written by
+ * huffman_compress_fd() or huffman_compress_stream()
+ * @in_fd: file descriptor to read the stream from
+ * @out_fd: file descriptor to write the decoded bytes to
+ * @params: stream options, only @threads and @stats apply, or NULL
+ * Return: int 1 on success, 0 on failure or if the stream is corrupt
+ */
+int huffman_decompress_fd(int in_fd, int out_fd,
+			  const huffman_params_t *params)
+{
+	return (huffman_decompress_stream(fd_read, &in_fd, fd_write, &out_fd,
+					  params));
+}
@@ -0,0 +1,128 @@
+#include "huffman.h"
+#include <string.h>
+
+/**
+ * flat_sort - sorts the leaves of a flat tree by increasing weight, ties
+ * in input order, with the same radix sort as huffman_sort() but on 16-bit
+ * indices, the parent array, not yet filled, serving as scratch
+ * @tree: flat tree whose weights and size are set
+ */
+static void flat_sort(huffman_flat_t *tree)
+{
+	uint16_t *order = tree->order, *tmp = tree->parent;
+	size_t count[256], max = 0, i, shift, pos, sum;
+
+	for (i = 0; i < tree->size; i++)
+	{
+		order[i] = (uint16_t)i;
+		max |= tree->weight[i];
+	}
+	for (shift = 0; shift < sizeof(size_t) * 8 && (max >> shift);
+	     shift += 8)
+	{
+		memset(count, 0, sizeof(count));
+		for (i = 0; i < tree->size; i++)
+			count[(tree->weight[i] >> shift) & 0xff]++;
+		for (i = 0, sum = 0; i < 256; i++)
+		{
+			pos = count[i];
+			count[i] = sum;
+			sum += pos;
+		}
+		for (i = 0; i < tree->size; i++)
+			tmp[count[(tree->weight[order[i]] >> shift) & 0xff]++] =
+				order[i];
+		memcpy(order, tmp, sizeof(*order) * tree->size);
+	}
+}
+
+/**
+ * flat_pop - removes the lighter of the two queue heads, a leaf winning
+ * ties, as queue_pop() does for huffman_tree()
+ * @tree: flat tree under construction
+ * @leaf: position in @tree->order of the next unmerged leaf
+ * @merged: index of the next merged node
+ * @tail: index one past the last merged node
+ * Return: index of the removed node
+ */
+static uint16_t flat_pop(const huffman_flat_t *tree, size_t *leaf,
+			 size_t *merged, size_t tail)
+{
+	if (*leaf < tree->size && (*merged == tail ||
+	    tree->weight[tree->order[*leaf]] <= tree->weight[*merged]))
+		return (tree->order[(*leaf)++]);
+	return ((uint16_t)(*merged)++);
+}
+
+/**
+ * huffman_flat_tree - builds the tree huffman_tree() would, node for node,
+ * inside @tree: no allocation, and every node is a few array slots away
+ * from its children rather than behind three pointers
+ * @data: array of symbols, below HUFFMAN_ALPHABET_MAX
+ * @freq: array of frequencies (same size as data)
+ * @size: number of elements in data and freq, at most HUFFMAN_ALPHABET_MAX
+ * @tree: receives the tree
+ * Return: int 1 on success, 0 on failure
+ */
+int huffman_flat_tree(const uint16_t *data, const size_t *freq, size_t size,
+		      huffman_flat_t *tree)
+{
+	size_t leaf = 0, merged, tail, i;
+	uint16_t a, b;
+
+	if (!data || !freq || !size || size > HUFFMAN_ALPHABET_MAX || !tree)
+		return (0);
+	for (i = 0; i < size; i++)
+	{
+		if (data[i] >= HUFFMAN_ALPHABET_MAX)
+			return (0);
+		tree->symbol[i] = data[i];
+		tree->weight[i] = freq[i];
+		tree->left[i] = tree->right[i] = HUFFMAN_FLAT_NONE;
+	}
+	tree->size = size;
+	flat_sort(tree);
+
+	/* merge the two lightest nodes until a single one remains */
+	for (merged = tail = size; (size - leaf) + (tail - merged) > 1;
+	     tail++)
+	{
+		a = flat_pop(tree, &leaf, &merged, tail);
+		b = flat_pop(tree, &leaf, &merged, tail);
+		tree->weight[tail] = tree->weight[a] + tree->weight[b];
+		tree->left[tail] = a;
+		tree->right[tail] = b;
+		tree->parent[a] = tree->parent[b] = (uint16_t)tail;
+	}
+	tree->root = leaf < size ? tree->order[leaf] : merged;
+	tree->parent[tree->root] = HUFFMAN_FLAT_NONE;
+	return (1);
+}
+
+/**
+ * huffman_flat_lengths - computes the code length of every leaf of a flat
+ * tree, its depth, in one pass down from the root: a merged node always
+ * has a greater index than its children
+ * @tree: flat tree built by huffman_flat_tree()
+ * @lengths: receives the code length of each symbol, in input order; 1 for
+ * the only symbol if there is just one
+ * Return: int 1 on success, 0 on failure
+ */
+int huffman_flat_lengths(const huffman_flat_t *tree, unsigned char *lengths)
+{
+	unsigned char depth[HUFFMAN_FLAT_NODES];
+	size_t i;
+
+	if (!tree || !lengths || !tree->size)
+		return (0);
+	if (tree->size == 1)
+	{
+		lengths[0] = 1;
+		return (1);
+	}
+	depth[tree->root] = 0;
+	for (i = tree->root; i-- > 0; )
+		depth[i] = depth[tree->parent[i]] + 1;
+	memcpy(lengths, depth, tree->size);
+	return (1);
+}
@@ -0,0 +1,133 @@
+#include "huffman.h"
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+/* sub-histograms counted in turn, so that runs of one byte value do not */
+/* make every increment wait for the previous one to reach memory */
+#define LANES		4
+/* bytes counted before the 32-bit sub-histograms are folded */
+#define CHUNK		((size_t)1 << 30)
+/* smallest share of the input worth a thread of its own */
+#define THREAD_MIN	((size_t)1 << 20)
+#define THREADS_MAX	16
+
+/**
+ * struct histogram_job_s - Share of the input counted by one thread
+ *
+ * @in: First byte of the share
+ * @n: Length of the share
+ * @freq: Counts of the share
+ */
+typedef struct histogram_job_s
+{
+	const uint8_t *in;
+	size_t n;
+	size_t freq[HUFFMAN_SYMBOLS];
+} histogram_job_t;
+
+/**
+ * histogram_count - adds the byte counts of a buffer to a histogram, eight
+ * bytes per 64-bit load, spread over LANES sub-histograms
+ * @in: input bytes
+ * @n: size_t length of @in
+ * @freq: histogram to add to
+ */
+static void histogram_count(const uint8_t *in, size_t n, size_t *freq)
+{
+	uint32_t c[LANES][HUFFMAN_SYMBOLS];
+	size_t i, len, s;
+	uint64_t w;
+
+	for (; n; in += len, n -= len)
+	{
+		len = n < CHUNK ? n : CHUNK;
+		memset(c, 0, sizeof(c));
+		for (i = 0; i + 8 <= len; i += 8)
+		{
+			memcpy(&w, in + i, sizeof(w));
+			c[0][(uint8_t)w]++;
+			c[1][(uint8_t)(w >> 8)]++;
+			c[2][(uint8_t)(w >> 16)]++;
+			c[3][(uint8_t)(w >> 24)]++;
+			c[0][(uint8_t)(w >> 32)]++;
+			c[1][(uint8_t)(w >> 40)]++;
+			c[2][(uint8_t)(w >> 48)]++;
+			c[3][(uint8_t)(w >> 56)]++;
+		}
+		for (; i < len; i++)
+			c[0][in[i]]++;
+		for (s = 0; s < HUFFMAN_SYMBOLS; s++)
+			freq[s] += (size_t)c[0][s] + c[1][s] + c[2][s] +
+				c[3][s];
+	}
+}
+
+/**
+ * histogram_thread - thread entry point counting one share of the input
+ * @arg: histogram_job_t pointer
+ * Return: NULL
+ */
+static void *histogram_thread(void *arg)
+{
+	histogram_job_t *job = arg;
+
+	histogram_count(job->in, job->n, job->freq);
+	return (NULL);
+}
+
+/**
+ * huffman_histogram - counts the occurrences of every byte value in a
+ * buffer; large buffers are split between threads, one per online CPU at
+ * most, whose histograms are summed at the end
+ * @in: input bytes
+ * @n: size_t length of @in
+ * @freq: receives the count of each of the HUFFMAN_SYMBOLS byte values
+ * Return: int 1 on success, 0 on failure
+ */
+int huffman_histogram(const uint8_t *in, size_t n, size_t *freq)
+{
+	histogram_job_t jobs[THREADS_MAX];
+	pthread_t tid[THREADS_MAX];
+	int started[THREADS_MAX] = {0};
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t nthreads = n / THREAD_MIN, share, i, s;
+
+	if ((!in && n) || !freq)
+		return (0);
+	memset(freq, 0, sizeof(*freq) * HUFFMAN_SYMBOLS);
+	if (cpus > 0 && nthreads > (size_t)cpus)
+		nthreads = (size_t)cpus;
+	if (nthreads > THREADS_MAX)
+		nthreads = THREADS_MAX;
+	if (nthreads < 2)
+	{
+		histogram_count(in, n, freq);
+		return (1);
+	}
+
+	share = n / nthreads;
+	for (i = 0; i < nthreads; i++)
+	{
+		jobs[i].in = in + i * share;
+		jobs[i].n = i + 1 < nthreads ? share : n - i * share;
+		memset(jobs[i].freq, 0, sizeof(jobs[i].freq));
+		if (i)
+			started[i] = !pthread_create(&tid[i], NULL,
+						     histogram_thread,
+						     &jobs[i]);
+	}
+	/* the calling thread takes the first share, and any share whose */
+	/* thread could not be started */
+	for (i = 0; i < nthreads; i++)
+		if (!i || !started[i])
+			histogram_thread(&jobs[i]);
+	for (i = 0; i < nthreads; i++)
+	{
+		if (started[i])
+			pthread_join(tid[i], NULL);
+		for (s = 0; s < HUFFMAN_SYMBOLS; s++)
+			freq[s] += jobs[i].freq[s];
+	}
+	return (1);
+}
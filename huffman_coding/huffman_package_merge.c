@@ -0,0 +1,136 @@
+#include "huffman.h"
+#include <stdlib.h>
+
+/**
+ * package_merge - computes length-limited code lengths with the
+ * package-merge algorithm (Larmore and Hirschberg): starting from the
+ * deepest level, the items of a level are paired into packages, which are
+ * merged with the leaves to form the level above; the 2n - 2 lightest
+ * items of the top level then decide the lengths, a leaf's length being
+ * the amount of levels it is selected at. Since leaves are sorted, the
+ * leaves selected at a level are always a prefix of them, so only their
+ * count per level is needed.
+ * @w: nonzero frequencies in increasing order
+ * @n: length of @w, at least 2 and at most 2 ^ @max
+ * @max: maximum code length
+ * @len: receives the code lengths, in decreasing order
+ * Return: int 1 on success, 0 on failure
+ */
+static int package_merge(const size_t *w, size_t n, unsigned int max,
+			 unsigned char *len)
+{
+	size_t *prev, *cur, *tmp, nprev = n, ncur, i, j, k, take;
+	unsigned char *leaf;
+	unsigned int level;
+
+	prev = malloc(sizeof(*prev) * 2 * n);
+	cur = malloc(sizeof(*cur) * 2 * n);
+	leaf = malloc(2 * n * max);
+	if (!prev || !cur || !leaf)
+		goto fail;
+
+	/* deepest level: the leaves alone */
+	for (i = 0; i < n; i++)
+	{
+		prev[i] = w[i];
+		leaf[(max - 1) * 2 * n + i] = 1;
+	}
+	for (level = max - 1; level > 0; level--)
+	{
+		/* merge the leaves with the packages of the level below */
+		for (i = 0, j = 0, ncur = 0; i < n || j + 1 < nprev; ncur++)
+		{
+			k = (level - 1) * 2 * n + ncur;
+			if (j + 1 >= nprev ||
+			    (i < n && w[i] <= prev[j] + prev[j + 1]))
+			{
+				cur[ncur] = w[i++];
+				leaf[k] = 1;
+			}
+			else
+			{
+				cur[ncur] = prev[j] + prev[j + 1];
+				j += 2;
+				leaf[k] = 0;
+			}
+		}
+		tmp = prev;
+		prev = cur;
+		cur = tmp;
+		nprev = ncur;
+	}
+
+	/* select 2n - 2 items at the top, then twice the packages among */
+	/* them at each level below */
+	for (i = 0; i < n; i++)
+		len[i] = 0;
+	for (level = 0, take = 2 * n - 2; level < max && take; level++)
+	{
+		for (k = 0, j = 0; k < take; k++)
+			j += leaf[level * 2 * n + k];
+		for (i = 0; i < j; i++)
+			len[i]++;
+		take = 2 * (take - j);
+	}
+	free(prev);
+	free(cur);
+	free(leaf);
+	return (1);
+fail:
+	free(prev);
+	free(cur);
+	free(leaf);
+	return (0);
+}
+
+/**
+ * huffman_code_lengths_limited - computes the code length of every symbol,
+ * none longer than @max_length: the optimal Huffman lengths when they
+ * already fit, otherwise the optimal lengths under that limit found by
+ * package-merge
+ * @freq: frequency array
+ * @size: size_t length of @freq and @lengths
+ * @lengths: receives the code length of each symbol; 0 for symbols of
+ * frequency 0, and 1 for the only symbol if there is just one
+ * @max_length: maximum code length, at most HUFFMAN_MAX_BITS
+ * Return: int 1 on success, 0 on failure or if the symbols cannot all get
+ * codes of at most @max_length bits
+ */
+int huffman_code_lengths_limited(size_t *freq, size_t size,
+				 unsigned char *lengths,
+				 unsigned int max_length)
+{
+	size_t *order = NULL, *w = NULL, i, n = 0, longest = 0;
+	unsigned char *len = NULL;
+	int ok = 0;
+
+	if (!max_length || max_length > HUFFMAN_MAX_BITS ||
+	    !huffman_code_lengths(freq, size, lengths))
+		return (0);
+	for (i = 0; i < size; i++)
+	{
+		n += lengths[i] != 0;
+		if (lengths[i] > longest)
+			longest = lengths[i];
+	}
+	if (longest <= max_length)
+		return (1);
+	if (n > (size_t)1 << max_length)
+		return (0);
+
+	order = huffman_sort(freq, size);
+	w = malloc(sizeof(*w) * n);
+	len = malloc(n);
+	if (order && w && len)
+	{
+		for (i = size - n; i < size; i++)
+			w[i - (size - n)] = freq[order[i]];
+		ok = package_merge(w, n, max_length, len);
+		for (i = 0; ok && i < n; i++)
+			lengths[order[size - n + i]] = len[i];
+	}
+	free(order);
+	free(w);
+	free(len);
+	return (ok);
+}
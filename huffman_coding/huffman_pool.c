@@ -0,0 +1,266 @@
+#include "huffman.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* blocks in flight per worker: one being coded, one waiting */
+#define SLOTS_PER_THREAD	2
+
+/**
+ * struct slot_s - One block in flight
+ *
+ * @in: Block read by the fill callback
+ * @out: Output of the job
+ * @n: Length of @in
+ * @size: Length of @out, or HUFFMAN_ERROR
+ * @done: Set once a worker has coded the block
+ */
+typedef struct slot_s
+{
+	uint8_t *in;
+	uint8_t *out;
+	size_t n;
+	size_t size;
+	int done;
+} slot_t;
+
+/**
+ * struct pool_state_s - Shared state of a running pool; slots form a ring
+ * in read order, so that the output is written in that order whatever
+ * order the workers finish in
+ *
+ * @pool: Description of the work
+ * @lock: Guards every field below
+ * @work: Signalled when a block is read, or when the workers must stop
+ * @done: Signalled when a block is coded
+ * @slots: Ring of blocks in flight
+ * @count: Amount of @slots
+ * @head: Amount of blocks read
+ * @next: Amount of blocks taken by workers
+ * @stop: Set once no more blocks will be read
+ */
+typedef struct pool_state_s
+{
+	const huffman_pool_t *pool;
+	pthread_mutex_t lock;
+	pthread_cond_t work;
+	pthread_cond_t done;
+	slot_t *slots;
+	size_t count;
+	size_t head;
+	size_t next;
+	int stop;
+} pool_state_t;
+
+/**
+ * struct worker_s - Arguments of a worker thread
+ *
+ * @state: Shared state
+ * @stats: Work done by the thread
+ */
+typedef struct worker_s
+{
+	pool_state_t *state;
+	huffman_thread_stats_t stats;
+} worker_t;
+
+/**
+ * now - reads a monotonic clock
+ * Return: double time in seconds
+ */
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((double)ts.tv_sec + (double)ts.tv_nsec / 1e9);
+}
+
+/**
+ * worker - codes blocks until the pool stops
+ * @arg: worker_t of the thread
+ * Return: NULL
+ */
+static void *worker(void *arg)
+{
+	worker_t *w = arg;
+	pool_state_t *st = w->state;
+	slot_t *s;
+	size_t size;
+	double start;
+
+	pthread_mutex_lock(&st->lock);
+	for (;;)
+	{
+		while (!st->stop && st->next == st->head)
+			pthread_cond_wait(&st->work, &st->lock);
+		if (st->next == st->head)
+			break;
+		s = &st->slots[st->next++ % st->count];
+		pthread_mutex_unlock(&st->lock);
+
+		start = now();
+		size = st->pool->job(st->pool->job_ctx, s->in, s->n, s->out,
+				     st->pool->out_size);
+		w->stats.seconds += now() - start;
+		w->stats.blocks++;
+		w->stats.bytes_in += s->n;
+		if (size != HUFFMAN_ERROR)
+			w->stats.bytes_out += size;
+
+		pthread_mutex_lock(&st->lock);
+		s->size = size;
+		s->done = 1;
+		pthread_cond_broadcast(&st->done);
+	}
+	pthread_mutex_unlock(&st->lock);
+	return (NULL);
+}
+
+/**
+ * pool_loop - reads blocks into free slots and writes coded ones, in the
+ * caller's thread, until the input ends or something fails
+ * @st: Shared state, locked on entry and on return
+ * Return: int 1 on success, 0 on failure
+ */
+static int pool_loop(pool_state_t *st)
+{
+	const huffman_pool_t *pool = st->pool;
+	size_t tail = 0, n;
+	slot_t *s;
+	int eof = 0, ok;
+
+	for (;;)
+	{
+		while (!eof && st->head - tail < st->count)
+		{
+			s = &st->slots[st->head % st->count];
+			pthread_mutex_unlock(&st->lock);
+			n = pool->fill(pool->fill_ctx, s->in, pool->in_size);
+			pthread_mutex_lock(&st->lock);
+			if (n == HUFFMAN_ERROR)
+				return (0);
+			if (!n)
+			{
+				eof = 1;
+				break;
+			}
+			s->n = n;
+			s->done = 0;
+			st->head++;
+			pthread_cond_signal(&st->work);
+		}
+		if (tail == st->head)
+			return (1);
+		s = &st->slots[tail % st->count];
+		while (!s->done)
+			pthread_cond_wait(&st->done, &st->lock);
+		pthread_mutex_unlock(&st->lock);
+		ok = s->size != HUFFMAN_ERROR &&
+			(!s->size || pool->wr(pool->wr_ctx, s->out, s->size));
+		pthread_mutex_lock(&st->lock);
+		if (!ok)
+			return (0);
+		tail++;
+	}
+}
+
+/**
+ * huffman_pool_run - codes blocks with a pool of worker threads: the
+ * caller's thread reads blocks and writes their output back in order,
+ * keeping two blocks in flight per worker, so memory use is bounded
+ * whatever the input size
+ * @pool: Description of the work
+ * Return: int 1 on success, 0 on failure
+ */
+int huffman_pool_run(const huffman_pool_t *pool)
+{
+	pool_state_t st;
+	worker_t *workers = NULL;
+	pthread_t *tid = NULL;
+	size_t i, started = 0;
+	int ok = 0;
+
+	if (!pool || !pool->fill || !pool->job || !pool->wr ||
+	    !pool->threads || pool->threads > HUFFMAN_THREADS_MAX)
+		return (0);
+	st.pool = pool;
+	st.count = (size_t)pool->threads * SLOTS_PER_THREAD;
+	st.head = st.next = 0;
+	st.stop = 0;
+	st.slots = calloc(st.count, sizeof(*st.slots));
+	workers = calloc(pool->threads, sizeof(*workers));
+	tid = malloc(pool->threads * sizeof(*tid));
+	if (!st.slots || !workers || !tid)
+		goto out;
+	if (pool->stats)
+		memset(pool->stats, 0, pool->threads * sizeof(*pool->stats));
+	for (i = 0; i < st.count; i++)
+	{
+		st.slots[i].in = malloc(pool->in_size);
+		st.slots[i].out = malloc(pool->out_size);
+		if (!st.slots[i].in || !st.slots[i].out)
+			goto out;
+	}
+
+	pthread_mutex_init(&st.lock, NULL);
+	pthread_cond_init(&st.work, NULL);
+	pthread_cond_init(&st.done, NULL);
+	for (; started < pool->threads; started++)
+	{
+		workers[started].state = &st;
+		if (pthread_create(&tid[started], NULL, worker,
+				   &workers[started]))
+			break;
+	}
+	pthread_mutex_lock(&st.lock);
+	ok = started && pool_loop(&st);
+	st.stop = 1;
+	pthread_cond_broadcast(&st.work);
+	pthread_mutex_unlock(&st.lock);
+	for (i = 0; i < started; i++)
+	{
+		pthread_join(tid[i], NULL);
+		if (pool->stats)
+			pool->stats[i] = workers[i].stats;
+	}
+	pthread_cond_destroy(&st.done);
+	pthread_cond_destroy(&st.work);
+	pthread_mutex_destroy(&st.lock);
+out:
+	for (i = 0; st.slots && i < st.count; i++)
+	{
+		free(st.slots[i].in);
+		free(st.slots[i].out);
+	}
+	free(st.slots);
+	free(workers);
+	free(tid);
+	return (ok);
+}
+
+/**
+ * huffman_stats_print - prints the work of each thread of a pool to
+ * stderr, throughput counting the uncompressed side, the larger one
+ * @stats: Array of @threads entries filled by huffman_pool_run()
+ * @threads: unsigned int amount of threads
+ */
+void huffman_stats_print(const huffman_thread_stats_t *stats,
+			 unsigned int threads)
+{
+	unsigned int i;
+	double in, out, mib, rate;
+
+	for (i = 0; stats && i < threads; i++)
+	{
+		in = (double)stats[i].bytes_in / (1 << 20);
+		out = (double)stats[i].bytes_out / (1 << 20);
+		mib = in > out ? in : out;
+		rate = stats[i].seconds > 0 ? mib / stats[i].seconds : 0.0;
+		fprintf(stderr, "thread %u: %lu blocks, %.1f MiB in, "
+			"%.1f MiB out, %.1f MiB/s\n", i, stats[i].blocks, in,
+			out, rate);
+	}
+}
@@ -1,4 +1,5 @@
 #include "huffman.h"
+#include <stdlib.h>
 
 /**
  * sym_cmp - compares two symbols
@@ -16,22 +17,28 @@ int sym_cmp(void *p1, void *p2)
 /**
  * huffman_priority_queue - allocates a priority queue for
  * *			    the Huffman coding algorithm
- * @data: char array
+ * @data: symbol array
  * @freq: freq array
  * @size: size_t length of @data and @freq
  * Return: heap_t pointer to allocated priority queue
  */
-heap_t *huffman_priority_queue(char *data, size_t *freq, size_t size)
+heap_t *huffman_priority_queue(uint16_t *data, size_t *freq, size_t size)
 {C99(
 	if (!data || !freq || !size) return (NULL);
-	heap_t *q = heap_create(sym_cmp);
-	if (!q) return (NULL);
+	void **leaves = calloc(size, sizeof(*leaves));
+	if (!leaves) return (NULL);
+	heap_t *q = NULL;
 	size_t i;
 	for (i = 0; i < size; ++i)
 	{
 		symbol_t *s = symbol_create(data[i], freq[i]);
-		if (heap_insert(q, binary_tree_node(NULL, s)) == NULL)
-			return (NULL);
+		leaves[i] = s ? binary_tree_node(NULL, s) : NULL;
+		if (!leaves[i]) { free(s); break; }
 	}
+	if (i == size)
+		q = heap_build(sym_cmp, leaves, size);
+	if (!q)
+		while (i--) free_binary_tree_node(leaves[i], free);
+	free(leaves);
 	return (q);
-);}
\ No newline at end of file
+);}
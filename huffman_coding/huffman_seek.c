@@ -0,0 +1,202 @@
+#include "huffman.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * le32_get - loads a 32-bit little-endian value
+ * @p: source
+ * Return: the value
+ */
+static size_t le32_get(const uint8_t *p)
+{
+	return ((size_t)p[0] | (size_t)p[1] << 8 | (size_t)p[2] << 16 |
+		(size_t)p[3] << 24);
+}
+
+/**
+ * le64_get - loads a 64-bit little-endian value
+ * @p: source
+ * Return: the value
+ */
+static uint64_t le64_get(const uint8_t *p)
+{
+	return ((uint64_t)le32_get(p) | (uint64_t)le32_get(p + 4) << 32);
+}
+
+/**
+ * pread_full - reads bytes at an offset of a file, however many calls it
+ * takes
+ * @fd: file descriptor
+ * @buf: buffer to fill
+ * @n: size_t amount of bytes to read
+ * @off: offset of the first byte in the file
+ * Return: int 1 if all @n bytes were read, 0 on failure or at the end of
+ * the file
+ */
+static int pread_full(int fd, uint8_t *buf, size_t n, uint64_t off)
+{
+	ssize_t got;
+
+	while (n)
+	{
+		got = pread(fd, buf, n, (off_t)off);
+		if (got < 0 && errno == EINTR)
+			continue;
+		if (got <= 0)
+			return (0);
+		buf += got;
+		n -= (size_t)got;
+		off += (uint64_t)got;
+	}
+	return (1);
+}
+
+/**
+ * struct seek_s - What huffman_read_range() knows of a stream
+ *
+ * @fd: File descriptor of the stream
+ * @block: Block size of the stream
+ * @total: Size of the decoded data
+ * @every: Amount of blocks between index entries
+ * @count: Amount of index entries
+ * @entries: Offset of the first index entry in the file
+ */
+typedef struct seek_s
+{
+	int fd;
+	size_t block;
+	uint64_t total;
+	size_t every;
+	size_t count;
+	uint64_t entries;
+} seek_t;
+
+/**
+ * seek_open - reads the header and the index footer of a stream
+ * @s: receives what was read, @fd set
+ * Return: int 1 on success, 0 if the file is not a stream with an index
+ */
+static int seek_open(seek_t *s)
+{
+	uint8_t head[HUFFMAN_STREAM_HEADER], foot[HUFFMAN_INDEX_FOOTER];
+	struct stat st;
+	uint64_t size, room;
+
+	if (fstat(s->fd, &st) || st.st_size < HUFFMAN_STREAM_HEADER +
+	    HUFFMAN_FRAME_HEADER + HUFFMAN_INDEX_FOOTER)
+		return (0);
+	size = (uint64_t)st.st_size;
+	if (!pread_full(s->fd, head, HUFFMAN_STREAM_HEADER, 0) ||
+	    !pread_full(s->fd, foot, HUFFMAN_INDEX_FOOTER,
+			size - HUFFMAN_INDEX_FOOTER) ||
+	    memcmp(foot + 16, HUFFMAN_INDEX_MAGIC, 4))
+		return (0);
+	s->block = huffman_stream_block(head);
+	s->total = le64_get(foot);
+	s->every = le32_get(foot + 8);
+	s->count = le32_get(foot + 12);
+	room = size - HUFFMAN_STREAM_HEADER - HUFFMAN_FRAME_HEADER -
+		HUFFMAN_INDEX_FOOTER;
+	if (!s->block || !s->every ||
+	    (uint64_t)s->count > room / HUFFMAN_INDEX_ENTRY)
+		return (0);
+	s->entries = size - HUFFMAN_INDEX_FOOTER -
+		(uint64_t)s->count * HUFFMAN_INDEX_ENTRY;
+	return (1);
+}
+
+/**
+ * seek_block - finds the frame of a block: its index entry, then the
+ * length fields of the frames in between, none of which is decoded
+ * @s: stream
+ * @block: number of the block
+ * @pos: receives the offset of its frame in the file
+ * Return: int 1 on success, 0 if the index or the stream is corrupt
+ */
+static int seek_block(const seek_t *s, uint64_t block, uint64_t *pos)
+{
+	uint8_t buf[HUFFMAN_INDEX_ENTRY];
+	uint64_t entry = block / s->every, i;
+
+	if (entry >= s->count ||
+	    !pread_full(s->fd, buf, HUFFMAN_INDEX_ENTRY,
+			s->entries + entry * HUFFMAN_INDEX_ENTRY) ||
+	    le64_get(buf + 8) != entry * s->every * s->block)
+		return (0);
+	*pos = le64_get(buf);
+	for (i = entry * s->every; i < block; i++)
+	{
+		if (!pread_full(s->fd, buf, HUFFMAN_FRAME_HEADER, *pos) ||
+		    !le32_get(buf))
+			return (0);
+		*pos += HUFFMAN_FRAME_HEADER + le32_get(buf);
+	}
+	return (1);
+}
+
+/**
+ * huffman_read_range - decodes a byte range of a stream compressed with a
+ * seek index (see huffman_params_t), the blocks before it skipped through
+ * the index: only the blocks holding the range are read and decoded
+ * @fd: file descriptor of the compressed stream, read with pread(), so
+ * that its file offset is left alone and threads can share it
+ * @off: offset of the range in the decoded data
+ * @len: size_t length of the range
+ * @out: receives the range
+ * Return: size_t amount of bytes decoded, less than @len only if the range
+ * runs past the end of the data, or HUFFMAN_ERROR if the file has no
+ * index, is corrupt or cannot be read
+ */
+size_t huffman_read_range(int fd, uint64_t off, size_t len, uint8_t *out)
+{
+	seek_t s = {0, 0, 0, 0, 0, 0};
+	uint8_t *frame = NULL, *block = NULL;
+	uint64_t pos, n;
+	size_t done = 0, skip, size, take;
+
+	s.fd = fd;
+	if ((!out && len) || !seek_open(&s))
+		return (HUFFMAN_ERROR);
+	if (off >= s.total || !len)
+		return (0);
+	if (len > s.total - off)
+		len = (size_t)(s.total - off);
+	frame = malloc(huffman_encode_bound(s.block));
+	block = malloc(s.block);
+	n = off / s.block;
+	if (!frame || !block || !seek_block(&s, n, &pos))
+		done = HUFFMAN_ERROR;
+	skip = (size_t)(off % s.block);
+	while (done != HUFFMAN_ERROR && done < len)
+	{
+		if (!pread_full(fd, frame, HUFFMAN_FRAME_HEADER, pos))
+		{
+			done = HUFFMAN_ERROR;
+			break;
+		}
+		size = le32_get(frame);
+		if (!size || size > huffman_encode_bound(s.block) ||
+		    !pread_full(fd, frame, size, pos + HUFFMAN_FRAME_HEADER))
+		{
+			done = HUFFMAN_ERROR;
+			break;
+		}
+		take = huffman_decode(frame, size, block, s.block);
+		if (take == HUFFMAN_ERROR || take <= skip)
+		{
+			done = HUFFMAN_ERROR;
+			break;
+		}
+		take = take - skip < len - done ? take - skip : len - done;
+		memcpy(out + done, block + skip, take);
+		done += take;
+		skip = 0;
+		pos += HUFFMAN_FRAME_HEADER + size;
+	}
+	free(frame);
+	free(block);
+	return (done);
+}
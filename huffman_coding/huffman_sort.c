@@ -0,0 +1,54 @@
+#include "huffman.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * huffman_sort - sorts symbol indices by increasing frequency, with a stable
+ * LSD radix sort on bytes of the frequencies, skipping the high bytes all
+ * frequencies leave empty: for typical block histograms that is one or two
+ * passes of 256 buckets
+ * @freq: frequency array
+ * @size: size_t length of @freq
+ * Return: malloc'd array of the @size indices into @freq, by increasing
+ * frequency (ties keep index order), or NULL on failure
+ */
+size_t *huffman_sort(size_t *freq, size_t size)
+{
+	size_t *order, *tmp, count[256], max = 0, i, shift, pos, sum;
+
+	if (!freq || !size)
+		return (NULL);
+
+	order = malloc(sizeof(*order) * size);
+	tmp = malloc(sizeof(*tmp) * size);
+	if (!order || !tmp)
+	{
+		free(order);
+		free(tmp);
+		return (NULL);
+	}
+	for (i = 0; i < size; i++)
+	{
+		order[i] = i;
+		max |= freq[i];
+	}
+	for (shift = 0; shift < sizeof(size_t) * 8 && (max >> shift);
+	     shift += 8)
+	{
+		memset(count, 0, sizeof(count));
+		for (i = 0; i < size; i++)
+			count[(freq[i] >> shift) & 0xff]++;
+		for (i = 0, sum = 0; i < 256; i++)
+		{
+			pos = count[i];
+			count[i] = sum;
+			sum += pos;
+		}
+		for (i = 0; i < size; i++)
+			tmp[count[(freq[order[i]] >> shift) & 0xff]++] =
+				order[i];
+		memcpy(order, tmp, sizeof(*order) * size);
+	}
+	free(tmp);
+	return (order);
+}
@@ -0,0 +1,460 @@
+#include "huffman.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * le32_put - stores a 32-bit value in little-endian byte order
+ * @p: destination
+ * @v: value
+ */
+static void le32_put(uint8_t *p, size_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * le64_put - stores a 64-bit value in little-endian byte order
+ * @p: destination
+ * @v: value
+ */
+static void le64_put(uint8_t *p, uint64_t v)
+{
+	le32_put(p, (size_t)(v & 0xffffffff));
+	le32_put(p + 4, (size_t)(v >> 32));
+}
+
+/**
+ * le32_get - loads a 32-bit little-endian value
+ * @p: source
+ * Return: the value
+ */
+static size_t le32_get(const uint8_t *p)
+{
+	return ((size_t)p[0] | (size_t)p[1] << 8 | (size_t)p[2] << 16 |
+		(size_t)p[3] << 24);
+}
+
+/**
+ * huffman_block_size - resolves the block size of the stream functions
+ * @params: encoding options, or NULL for the defaults
+ * Return: size_t block size, or 0 if @params asks for an invalid one
+ */
+size_t huffman_block_size(const huffman_params_t *params)
+{
+	if (!params || !params->block_size)
+		return (HUFFMAN_BLOCK_DEFAULT);
+	if (params->block_size > HUFFMAN_BLOCK_MAX)
+		return (0);
+	return (params->block_size);
+}
+
+/**
+ * huffman_stream_header - writes the header of a stream
+ * @out: receives HUFFMAN_STREAM_HEADER bytes
+ * @block_size: size_t most any block of the stream decodes to
+ * Return: size_t amount of bytes written
+ */
+size_t huffman_stream_header(uint8_t *out, size_t block_size)
+{
+	memcpy(out, HUFFMAN_MAGIC, 4);
+	out[4] = HUFFMAN_VERSION;
+	le32_put(out + 5, block_size);
+	return (HUFFMAN_STREAM_HEADER);
+}
+
+/**
+ * huffman_frame_bound - worst case size of a frame
+ * @block_size: size_t length of the block the frame holds
+ * Return: size_t amount of bytes huffman_frame_encode() may need
+ */
+size_t huffman_frame_bound(size_t block_size)
+{
+	return (HUFFMAN_FRAME_HEADER + huffman_encode_bound(block_size));
+}
+
+/**
+ * huffman_frame_encode - encodes one block of a stream, with its own code
+ * table or raw, preceded by its encoded length
+ * @in: input bytes
+ * @n: size_t length of @in, at most the block size of the stream
+ * @out: output buffer, huffman_frame_bound(@n) bytes are always enough
+ * @cap: size_t length of @out
+ * @params: encoding options, or NULL for the defaults
+ * Return: size_t amount of bytes written, 0 on failure
+ */
+size_t huffman_frame_encode(const uint8_t *in, size_t n, uint8_t *out,
+			    size_t cap, const huffman_params_t *params)
+{
+	size_t size;
+
+	if (!out || cap < HUFFMAN_FRAME_HEADER)
+		return (0);
+	size = huffman_encode_params(in, n, out + HUFFMAN_FRAME_HEADER,
+				     cap - HUFFMAN_FRAME_HEADER, params);
+	if (!size)
+		return (0);
+	le32_put(out, size);
+	return (HUFFMAN_FRAME_HEADER + size);
+}
+
+/**
+ * read_full - reads from a callback until a buffer is full or the input
+ * ends
+ * @rd: input callback
+ * @rctx: context of @rd
+ * @buf: buffer to fill
+ * @n: size_t length of @buf
+ * Return: size_t amount of bytes read, or HUFFMAN_ERROR
+ */
+static size_t read_full(huffman_read_t rd, void *rctx, uint8_t *buf, size_t n)
+{
+	size_t total = 0, got;
+
+	while (total < n)
+	{
+		got = rd(rctx, buf + total, n - total);
+		if (got == HUFFMAN_ERROR)
+			return (HUFFMAN_ERROR);
+		if (!got)
+			break;
+		total += got;
+	}
+	return (total);
+}
+
+/**
+ * struct stream_in_s - Input of the stream functions
+ *
+ * @rd: Input callback
+ * @rctx: Context of @rd
+ * @end: Set once the input is exhausted
+ * @total: Amount of bytes read
+ */
+typedef struct stream_in_s
+{
+	huffman_read_t rd;
+	void *rctx;
+	int end;
+	uint64_t total;
+} stream_in_t;
+
+/**
+ * struct index_out_s - Output of a stream that gets a seek index
+ *
+ * @wr: Output callback
+ * @wctx: Context of @wr
+ * @pos: Stream offset of the next frame
+ * @frames: Amount of frames written
+ * @block: Block size of the stream
+ * @every: Amount of blocks between index entries
+ * @entries: Index entries so far, HUFFMAN_INDEX_ENTRY bytes each
+ * @count: Amount of entries in @entries
+ * @cap: Amount of entries @entries has room for
+ */
+typedef struct index_out_s
+{
+	huffman_write_t wr;
+	void *wctx;
+	uint64_t pos;
+	size_t frames;
+	size_t block;
+	size_t every;
+	uint8_t *entries;
+	size_t count;
+	size_t cap;
+} index_out_t;
+
+/**
+ * fill_block - huffman_read_t reading the next block to compress
+ * @ctx: stream_in_t
+ * @buf: buffer to fill
+ * @n: size_t block size
+ * Return: size_t length of the block, 0 past the end of the input, or
+ * HUFFMAN_ERROR
+ */
+static size_t fill_block(void *ctx, uint8_t *buf, size_t n)
+{
+	stream_in_t *in = ctx;
+	size_t got;
+
+	if (in->end)
+		return (0);
+	got = read_full(in->rd, in->rctx, buf, n);
+	if (got != HUFFMAN_ERROR && got < n)
+		in->end = 1;
+	if (got != HUFFMAN_ERROR)
+		in->total += got;
+	return (got);
+}
+
+/**
+ * index_write - huffman_write_t passing frames on, and noting the offsets
+ * of every @every-th one for the seek index; the pool writes each frame
+ * with a call of its own, in order
+ * @ctx: index_out_t
+ * @buf: frame
+ * @n: size_t length of @buf
+ * Return: int 1 on success, 0 on failure
+ */
+static int index_write(void *ctx, const uint8_t *buf, size_t n)
+{
+	index_out_t *out = ctx;
+	uint8_t *grown;
+
+	if (out->frames % out->every == 0)
+	{
+		if (out->count == out->cap)
+		{
+			out->cap = out->cap ? out->cap * 2 : 64;
+			grown = realloc(out->entries,
+					out->cap * HUFFMAN_INDEX_ENTRY);
+			if (!grown)
+				return (0);
+			out->entries = grown;
+		}
+		grown = out->entries + out->count++ * HUFFMAN_INDEX_ENTRY;
+		le64_put(grown, out->pos);
+		le64_put(grown + 8, (uint64_t)out->frames * out->block);
+	}
+	out->pos += n;
+	out->frames++;
+	return (out->wr(out->wctx, buf, n));
+}
+
+/**
+ * index_finish - writes the seek index after the end marker
+ * @out: index_out_t the stream went through
+ * @total: size of the decoded data
+ * Return: int 1 on success, 0 on failure
+ */
+static int index_finish(index_out_t *out, uint64_t total)
+{
+	uint8_t foot[HUFFMAN_INDEX_FOOTER];
+
+	if (out->count > 0xffffffff)
+		return (0);
+	if (out->count && !out->wr(out->wctx, out->entries,
+				   out->count * HUFFMAN_INDEX_ENTRY))
+		return (0);
+	le64_put(foot, total);
+	le32_put(foot + 8, out->every);
+	le32_put(foot + 12, out->count);
+	memcpy(foot + 16, HUFFMAN_INDEX_MAGIC, 4);
+	return (out->wr(out->wctx, foot, HUFFMAN_INDEX_FOOTER));
+}
+
+/**
+ * fill_frame - huffman_read_t reading the next frame to decompress
+ * @ctx: stream_in_t
+ * @buf: buffer to fill with the block the frame holds
+ * @n: size_t length of @buf
+ * Return: size_t length of the block, 0 at the end marker, or
+ * HUFFMAN_ERROR if the stream is truncated or corrupt
+ */
+static size_t fill_frame(void *ctx, uint8_t *buf, size_t n)
+{
+	stream_in_t *in = ctx;
+	uint8_t head[HUFFMAN_FRAME_HEADER];
+	size_t len;
+
+	if (in->end)
+		return (0);
+	if (read_full(in->rd, in->rctx, head, HUFFMAN_FRAME_HEADER) !=
+	    HUFFMAN_FRAME_HEADER)
+		return (HUFFMAN_ERROR);
+	len = le32_get(head);
+	if (!len)
+		in->end = 1;
+	else if (len > n || read_full(in->rd, in->rctx, buf, len) != len)
+		return (HUFFMAN_ERROR);
+	return (len);
+}
+
+/**
+ * job_compress - huffman_job_t compressing a block into a frame
+ * @ctx: huffman_params_t, or NULL
+ * @in: block
+ * @n: size_t length of @in
+ * @out: output buffer
+ * @cap: size_t length of @out
+ * Return: size_t length of the frame, or HUFFMAN_ERROR
+ */
+static size_t job_compress(void *ctx, const uint8_t *in, size_t n,
+			   uint8_t *out, size_t cap)
+{
+	size_t size = huffman_frame_encode(in, n, out, cap, ctx);
+
+	return (size ? size : HUFFMAN_ERROR);
+}
+
+/**
+ * job_decompress - huffman_job_t decoding the block of a frame
+ * @ctx: unused
+ * @in: block
+ * @n: size_t length of @in
+ * @out: output buffer
+ * @cap: size_t length of @out
+ * Return: size_t length of the decoded block, or HUFFMAN_ERROR
+ */
+static size_t job_decompress(void *ctx, const uint8_t *in, size_t n,
+			     uint8_t *out, size_t cap)
+{
+	(void)ctx;
+	return (huffman_decode(in, n, out, cap));
+}
+
+/**
+ * stream_run - codes every block of a stream, with a pool of threads if
+ * @params asks for one, one block at a time in the caller's thread
+ * otherwise
+ * @pool: description of the work, @threads and @stats are taken from
+ * @params
+ * @params: stream options, or NULL for the defaults
+ * Return: int 1 on success, 0 on failure
+ */
+static int stream_run(huffman_pool_t *pool, const huffman_params_t *params)
+{
+	uint8_t *in, *out;
+	size_t n, size;
+	int ok = 0;
+
+	if (params && (params->threads > 1 || params->stats))
+	{
+		pool->threads = params->threads ? params->threads : 1;
+		pool->stats = params->stats;
+		return (huffman_pool_run(pool));
+	}
+	in = malloc(pool->in_size);
+	out = malloc(pool->out_size);
+	while (in && out)
+	{
+		n = pool->fill(pool->fill_ctx, in, pool->in_size);
+		if (n == HUFFMAN_ERROR)
+			break;
+		if (!n)
+		{
+			ok = 1;
+			break;
+		}
+		size = pool->job(pool->job_ctx, in, n, out, pool->out_size);
+		if (size == HUFFMAN_ERROR ||
+		    (size && !pool->wr(pool->wr_ctx, out, size)))
+			break;
+	}
+	free(in);
+	free(out);
+	return (ok);
+}
+
+/**
+ * huffman_compress_stream - compresses an input of any length into the
+ * framed stream format (see huffman.h), one block at a time: memory use is
+ * a block and a frame per block in flight, whatever the input size, plus
+ * the seek index if @params asks for one
+ * @rd: input callback
+ * @rctx: context of @rd
+ * @wr: output callback
+ * @wctx: context of @wr
+ * @params: stream options, or NULL for the defaults
+ * Return: int 1 on success, 0 on failure
+ */
+int huffman_compress_stream(huffman_read_t rd, void *rctx,
+			    huffman_write_t wr, void *wctx,
+			    const huffman_params_t *params)
+{
+	size_t block = huffman_block_size(params), size;
+	uint8_t head[HUFFMAN_STREAM_HEADER];
+	stream_in_t in = {NULL, NULL, 0, 0};
+	index_out_t index = {NULL, NULL, 0, 0, 0, 0, NULL, 0, 0};
+	huffman_pool_t pool = {0};
+	int ok;
+
+	if (!rd || !wr || !block)
+		return (0);
+	size = huffman_stream_header(head, block);
+	if (!wr(wctx, head, size))
+		return (0);
+	in.rd = rd;
+	in.rctx = rctx;
+	pool.in_size = block;
+	pool.out_size = huffman_frame_bound(block);
+	pool.fill = fill_block;
+	pool.fill_ctx = &in;
+	pool.job = job_compress;
+	pool.job_ctx = (void *)params;
+	pool.wr = wr;
+	pool.wr_ctx = wctx;
+	if (params && params->index_interval)
+	{
+		index.wr = wr;
+		index.wctx = wctx;
+		index.pos = size;
+		index.block = block;
+		index.every = params->index_interval;
+		pool.wr = index_write;
+		pool.wr_ctx = &index;
+	}
+	memset(head, 0, HUFFMAN_FRAME_HEADER);
+	ok = stream_run(&pool, params) &&
+		wr(wctx, head, HUFFMAN_FRAME_HEADER) &&
+		(!index.every || index_finish(&index, in.total));
+	free(index.entries);
+	return (ok);
+}
+
+/**
+ * huffman_stream_block - reads the header of a stream
+ * @head: HUFFMAN_STREAM_HEADER bytes
+ * Return: size_t block size of the stream, or 0 if @head is not a valid
+ * stream header
+ */
+size_t huffman_stream_block(const uint8_t *head)
+{
+	size_t block;
+
+	if (memcmp(head, HUFFMAN_MAGIC, 4) || head[4] != HUFFMAN_VERSION)
+		return (0);
+	block = le32_get(head + 5);
+	return (block && block <= HUFFMAN_BLOCK_MAX ? block : 0);
+}
+
+/**
+ * huffman_decompress_stream - decompresses a stream written by
+ * huffman_compress_stream(), one frame at a time
+ * @rd: input callback
+ * @rctx: context of @rd
+ * @wr: output callback
+ * @wctx: context of @wr
+ * @params: stream options, only @threads and @stats apply, or NULL
+ * Return: int 1 on success, 0 on failure or if the stream is corrupt
+ */
+int huffman_decompress_stream(huffman_read_t rd, void *rctx,
+			      huffman_write_t wr, void *wctx,
+			      const huffman_params_t *params)
+{
+	uint8_t head[HUFFMAN_STREAM_HEADER];
+	stream_in_t in = {NULL, NULL, 0, 0};
+	huffman_pool_t pool = {0};
+	size_t block;
+
+	if (!rd || !wr ||
+	    read_full(rd, rctx, head, HUFFMAN_STREAM_HEADER) !=
+	    HUFFMAN_STREAM_HEADER)
+		return (0);
+	block = huffman_stream_block(head);
+	if (!block)
+		return (0);
+	in.rd = rd;
+	in.rctx = rctx;
+	pool.in_size = huffman_encode_bound(block);
+	pool.out_size = block;
+	pool.fill = fill_frame;
+	pool.fill_ctx = &in;
+	pool.job = job_decompress;
+	pool.wr = wr;
+	pool.wr_ctx = wctx;
+	return (stream_run(&pool, params));
+}
@@ -0,0 +1,216 @@
+#include "huffman.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * tree_walk - records the depth of every leaf below a Huffman tree node
+ * @node: node_t pointer holding a symbol_t
+ * @depth: depth of @node
+ * @lengths: receives the depth of each leaf, indexed by its symbol
+ * Return: int 1 on success, 0 if a leaf is deeper than HUFFMAN_MAX_BITS
+ */
+static int tree_walk(const binary_tree_node_t *node, size_t depth,
+		     unsigned char *lengths)
+{
+	if (!node)
+		return (1);
+	if (node->left || node->right)
+		return (tree_walk(node->left, depth + 1, lengths) &&
+			tree_walk(node->right, depth + 1, lengths));
+	if (depth > HUFFMAN_MAX_BITS)
+		return (0);
+	lengths[((symbol_t *)node->data)->data] = (unsigned char)depth;
+	return (1);
+}
+
+/**
+ * huffman_tree_lengths - reads the code lengths of a Huffman tree, all a
+ * table needs to rebuild codes as short as the tree's
+ * @root: root of a tree built by huffman_tree()
+ * @lengths: receives the code length of each of the HUFFMAN_ALPHABET_MAX
+ * symbols, 0 for symbols missing from the tree, and 1 for the only symbol
+ * if there is just one
+ * Return: int 1 on success, 0 if a code is longer than HUFFMAN_MAX_BITS
+ */
+int huffman_tree_lengths(const binary_tree_node_t *root,
+			 unsigned char *lengths)
+{
+	if (!root || !lengths)
+		return (0);
+	memset(lengths, 0, HUFFMAN_ALPHABET_MAX);
+	if (!root->left && !root->right)
+		return (tree_walk(root, 1, lengths));
+	return (tree_walk(root, 0, lengths));
+}
+
+/**
+ * huffman_table_build - derives the canonical codes and the decoding
+ * tables of an alphabet from its code lengths
+ * @lengths: code length of each symbol, 0 if it is not coded
+ * @size: size_t amount of symbols, at most HUFFMAN_ALPHABET_MAX
+ * @table: receives the table, released by huffman_table_free() before it
+ * is built again
+ * Return: int 1 on success, 0 if the lengths are not a usable code
+ */
+int huffman_table_build(const unsigned char *lengths, size_t size,
+			huffman_table_t *table)
+{
+	uint16_t sym[HUFFMAN_ALPHABET_MAX];
+	unsigned char len[HUFFMAN_ALPHABET_MAX];
+	uint32_t code[HUFFMAN_ALPHABET_MAX];
+	huffman_entry_t *t;
+	size_t nsym = 0, i;
+
+	if (!lengths || !table || size > HUFFMAN_ALPHABET_MAX)
+		return (0);
+	table->decode = NULL;
+	memset(table->lengths, 0, sizeof(table->lengths));
+	memcpy(table->lengths, lengths, size);
+	if (!huffman_canonical_codes(table->lengths, HUFFMAN_ALPHABET_MAX,
+				     table->codes))
+		return (0);
+	for (i = 0; i < size; i++)
+	{
+		if (!lengths[i])
+			continue;
+		sym[nsym] = (uint16_t)i;
+		len[nsym] = lengths[i];
+		code[nsym++] = table->codes[i].bits;
+	}
+	if (!nsym || !huffman_lookup_build(nsym, sym, len, code, table->stack,
+					   &t))
+		return (0);
+	if (t != table->stack)
+		table->decode = t;
+	return (1);
+}
+
+/**
+ * huffman_table_save - serializes a code table
+ * @table: table
+ * @out: receives at most HUFFMAN_TABLE_SAVE_MAX bytes
+ * Return: size_t amount of bytes written, 0 on failure
+ */
+size_t huffman_table_save(const huffman_table_t *table, uint8_t *out)
+{
+	if (!table || !out)
+		return (0);
+	memcpy(out, HUFFMAN_TABLE_MAGIC, 4);
+	return (4 + huffman_lengths_write(table->lengths, HUFFMAN_ALPHABET_MAX,
+					  out + 4));
+}
+
+/**
+ * huffman_table_load - loads a table serialized by huffman_table_save(),
+ * building its decoding tables straight from the code lengths
+ * @in: serialized table
+ * @n: size_t length of @in
+ * @table: receives the table
+ * Return: size_t amount of bytes read, 0 if @in is not a valid table
+ */
+size_t huffman_table_load(const uint8_t *in, size_t n, huffman_table_t *table)
+{
+	unsigned char lengths[HUFFMAN_ALPHABET_MAX];
+	size_t size;
+
+	if (!in || !table || n < 4 || memcmp(in, HUFFMAN_TABLE_MAGIC, 4))
+		return (0);
+	size = huffman_lengths_read(in + 4, n - 4, HUFFMAN_ALPHABET_MAX,
+				    lengths);
+	if (!size || !huffman_table_build(lengths, HUFFMAN_ALPHABET_MAX, table))
+		return (0);
+	return (4 + size);
+}
+
+/**
+ * huffman_table_encode - codes symbols with a table, the codes going out
+ * through a 64-bit accumulator, a byte at a time
+ * @table: table
+ * @in: symbols
+ * @count: size_t amount of symbols in @in
+ * @out: output buffer
+ * @cap: size_t length of @out
+ * Return: size_t amount of bytes written, or HUFFMAN_ERROR if @out is too
+ * small or a symbol has no code
+ */
+size_t huffman_table_encode(const huffman_table_t *table, const uint16_t *in,
+			    size_t count, uint8_t *out, size_t cap)
+{
+	const huffman_code_t *c;
+	size_t bits = 0, i;
+	uint64_t acc = 0;
+	unsigned int nbits = 0;
+
+	if (!table || (!in && count) || (!out && cap))
+		return (HUFFMAN_ERROR);
+	for (i = 0; i < count; i++)
+	{
+		if (in[i] >= HUFFMAN_ALPHABET_MAX || !table->lengths[in[i]])
+			return (HUFFMAN_ERROR);
+		bits += table->lengths[in[i]];
+	}
+	if (cap < (bits + 7) / 8)
+		return (HUFFMAN_ERROR);
+	for (i = 0; i < count; i++)
+	{
+		c = &table->codes[in[i]];
+		acc |= (uint64_t)c->bits << nbits;
+		nbits += c->length;
+		for (; nbits >= 8; nbits -= 8, acc >>= 8)
+			*out++ = (uint8_t)acc;
+	}
+	if (nbits)
+		*out = (uint8_t)acc;
+	return ((bits + 7) / 8);
+}
+
+/**
+ * huffman_table_decode - decodes symbols coded by huffman_table_encode()
+ * with the same table, one table lookup per symbol, two for codes longer
+ * than HUFFMAN_LOOKUP_BITS bits
+ * @table: table
+ * @in: coded symbols
+ * @n: size_t length of @in
+ * @out: receives the symbols
+ * @count: size_t amount of symbols to decode
+ * Return: size_t @count, or HUFFMAN_ERROR if @in is corrupt or too short
+ */
+size_t huffman_table_decode(const huffman_table_t *table, const uint8_t *in,
+			    size_t n, uint16_t *out, size_t count)
+{
+	const huffman_entry_t *t;
+	huffman_entry_t e;
+	size_t pos = 0, i;
+	uint64_t acc = 0;
+	unsigned int nbits = 0;
+
+	if (!table || (!in && n) || (!out && count))
+		return (HUFFMAN_ERROR);
+	t = table->decode ? table->decode : table->stack;
+	for (i = 0; i < count; i++)
+	{
+		/* bytes past the end read as zeros, caught below */
+		for (; nbits <= 56; nbits += 8, pos++)
+			acc |= (uint64_t)(pos < n ? in[pos] : 0) << nbits;
+		e = huffman_lookup(t, acc);
+		if (!e.length)
+			return (HUFFMAN_ERROR);
+		acc >>= e.length;
+		nbits -= e.length;
+		out[i] = (uint16_t)e.value;
+	}
+	return (pos * 8 - nbits <= n * 8 ? count : HUFFMAN_ERROR);
+}
+
+/**
+ * huffman_table_free - releases the decoding table a code table allocated
+ * for its longest codes, if any
+ * @table: table, may be NULL
+ */
+void huffman_table_free(huffman_table_t *table)
+{
+	if (!table)
+		return;
+	free(table->decode);
+	table->decode = NULL;
+}
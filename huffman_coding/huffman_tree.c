@@ -2,36 +2,119 @@
 #include <stdlib.h>
 
 /**
- * huffman_tree - builds a Huffman tree from characters and their frequencies
- * @data: array of characters
+ * node_freq - frequency of a Huffman tree node
+ * @node: node_t pointer holding a symbol_t
+ * Return: frequency of the node's symbol
+ */
+static size_t node_freq(node_t *node)
+{
+	return (((symbol_t *)node->data)->freq);
+}
+
+/**
+ * queue_pop - removes the lighter of the two queue heads: the next unmerged
+ * leaf, or the next merged node (a leaf wins ties, which keeps the tree
+ * as shallow as possible)
+ * @q: queue buffer, leaves at [0, @size) and merged nodes after them
+ * @size: number of leaves
+ * @leaf: index of the next unmerged leaf, advanced if it is taken
+ * @merged: index of the next merged node, advanced if it is taken
+ * @tail: index one past the last merged node
+ * Return: node_t pointer to the removed node
+ */
+static node_t *queue_pop(node_t **q, size_t size, size_t *leaf,
+			 size_t *merged, size_t tail)
+{
+	if (*leaf < size &&
+	    (*merged == tail || node_freq(q[*leaf]) <= node_freq(q[*merged])))
+		return (q[(*leaf)++]);
+	return (q[(*merged)++]);
+}
+
+/**
+ * queue_free - frees every tree still waiting in the queues after a failure
+ * @q: queue buffer
+ * @size: number of leaves
+ * @leaf: index of the next unmerged leaf
+ * @merged: index of the next merged node
+ * @tail: index one past the last merged node
+ */
+static void queue_free(node_t **q, size_t size, size_t leaf, size_t merged,
+		       size_t tail)
+{
+	for (; leaf < size; leaf++)
+		free_binary_tree_node(q[leaf], free);
+	for (; merged < tail; merged++)
+		free_binary_tree_node(q[merged], free);
+	free(q);
+}
+
+/**
+ * huffman_tree - builds a Huffman tree from symbols and their frequencies
+ * in O(n) after sorting: leaves are taken in order of frequency from one
+ * FIFO queue, and merged nodes, which come out in order of frequency too,
+ * go to a second one, so the two lightest nodes are always at the heads
+ * @data: array of symbols, below HUFFMAN_ALPHABET_MAX
  * @freq: array of frequencies (same size as data)
  * @size: number of elements in data and freq
  *
  * Return: pointer to root of Huffman tree, or NULL on failure
  */
-binary_tree_node_t *huffman_tree(char *data, size_t *freq, size_t size)
+binary_tree_node_t *huffman_tree(uint16_t *data, size_t *freq, size_t size)
 {
-	heap_t *q;
-	binary_tree_node_t *root;
+	node_t **q, *a = NULL, *b = NULL, *n = NULL;
+	size_t *order, leaf = 0, merged, tail, i;
+	symbol_t *s;
 
 	if (!data || !freq || size == 0)
 		return (NULL);
 
-	/* create priority queue (min heap) */
-	q = huffman_priority_queue(data, freq, size);
-	if (!q)
+	order = huffman_sort(freq, size);
+	q = malloc(sizeof(*q) * (2 * size - 1));
+	if (!order || !q)
+	{
+		free(order);
+		free(q);
 		return (NULL);
+	}
+	for (i = 0; i < size; i++)
+	{
+		s = symbol_create(data[order[i]], freq[order[i]]);
+		q[i] = s ? binary_tree_node(NULL, s) : NULL;
+		if (!q[i])
+		{
+			free(s);
+			free(order);
+			queue_free(q, i, 0, 0, 0);
+			return (NULL);
+		}
+	}
+	free(order);
 
-	/* repeatedly extract two smallest nodes and merge until one node remains */
-	while (q->size > 1)
-		huffman_extract_and_insert(q);
-
-	/* the remaining node in the heap is the root of the Huffman tree */
-	root = (binary_tree_node_t *)q->root->data;
+	/* merge the two lightest nodes until a single one remains */
+	for (merged = tail = size; (size - leaf) + (tail - merged) > 1; )
+	{
+		a = queue_pop(q, size, &leaf, &merged, tail);
+		b = queue_pop(q, size, &leaf, &merged, tail);
+		s = symbol_internal(node_freq(a) + node_freq(b));
+		n = s ? binary_tree_node(NULL, s) : NULL;
+		if (!n)
+		{
+			free(s);
+			free_binary_tree_node(a, free);
+			free_binary_tree_node(b, free);
+			queue_free(q, size, leaf, merged, tail);
+			return (NULL);
+		}
+		n->left = a;
+		n->right = b;
+		a->parent = b->parent = n;
+		q[tail++] = n;
+	}
 
-	/* free the heap structure (not the node itself) */
-	free(q->root);
+	/* the remaining node is the root of the Huffman tree */
+	n = leaf < size ? q[leaf] : q[merged];
 	free(q);
 
-	return (root);
-}
\ No newline at end of file
+	return (n);
+}
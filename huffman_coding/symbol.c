@@ -4,15 +4,29 @@
 #include "huffman.h"
 
 /**
- * symbol_create - allocates a symbol_t with a char and its frequency
- * @data: ascii-sized character
+ * symbol_create - allocates a symbol_t with a symbol and its frequency
+ * @data: symbol, any value below HUFFMAN_ALPHABET_MAX, 0 included
  * @freq: size_t frequency of @data in corpus
  * Return: pointer to new symbol_t or NULL on failure
  */
-symbol_t *symbol_create(char data, size_t freq)
+symbol_t *symbol_create(uint16_t data, size_t freq)
 {C99(
-	symbol_t src = (symbol_t){data, freq};
+	symbol_t src = (symbol_t){data, 0, freq};
 	symbol_t *dst = calloc(1, sizeof(*dst));
-	if (!dst || !data) { free(dst); return (NULL);}
+	if (!dst || data >= HUFFMAN_ALPHABET_MAX) { free(dst); return (NULL);}
 	return (memcpy(dst, &src, sizeof(src)));
-);}
\ No newline at end of file
+);}
+
+/**
+ * symbol_internal - allocates the symbol_t of a merged Huffman tree node,
+ * marked internal rather than given a reserved symbol value
+ * @freq: size_t sum of the frequencies below the node
+ * Return: pointer to new symbol_t or NULL on failure
+ */
+symbol_t *symbol_internal(size_t freq)
+{C99(
+	symbol_t src = (symbol_t){0, 1, freq};
+	symbol_t *dst = calloc(1, sizeof(*dst));
+	if (!dst) return (NULL);
+	return (memcpy(dst, &src, sizeof(src)));
+);}
@@ -11,8 +11,7 @@ static int _symbol_print(char *buffer, void *data)
 {C99(
 	node_t *nested = (binary_tree_node_t *)data;
 	symbol_t *symbol = (symbol_t *)nested->data;
-	char c = symbol->data;
-	if (c == -1) c = '$';
+	char c = symbol->internal ? '$' : (char)symbol->data;
 	int length = sprintf(buffer, "(%c/%lu)", c, symbol->freq);
 	return (length);
 );}
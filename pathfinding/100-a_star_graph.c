@@ -7,7 +7,7 @@
 #include <string.h>
 /* ULONG_MAX */
 #include <limits.h>
-/* euclideanDist */
+/* euclideanDist heuristic_dist */
 #include "euclideanDist.c"
 
 
@@ -209,18 +209,19 @@ int aStarGraph(a_star_vertex_t *as_queue, size_t nb_vertices,
 
 
 /**
-  * a_star_graph - searches for the shortest and fastest path from a starting
-  *   point to a target point in a graph, using the A* algorithm with Euclidean
-  *   distance between vertex and target as the additional heuristic
+  * a_star_graph_heuristic - searches for the shortest and fastest path from
+  *   a starting point to a target point in a graph, using the A* algorithm
+  *   with the chosen distance between vertex and target as the heuristic
   *
   * @graph: pointer to the graph to traverse
   * @start: pointer to starting vertex
   * @target: pointer to target vertex
+  * @heuristic: distance used to estimate the remaining cost to @target
   * Return: returns a queue in which each node is a `char *` corresponding to a
   *   vertex, forming a path from start to target, or NULL on failure
   */
-queue_t *a_star_graph(graph_t *graph, vertex_t const *start,
-		      vertex_t const *target)
+queue_t *a_star_graph_heuristic(graph_t *graph, vertex_t const *start,
+				vertex_t const *target, heuristic_t heuristic)
 {
 	a_star_vertex_t *a_star_queue = NULL;
 	vertex_t *temp_v = NULL;
@@ -239,7 +240,8 @@ queue_t *a_star_graph(graph_t *graph, vertex_t const *start,
 	     i++, temp_v = temp_v->next)
 	{
 		a_star_queue[i].vertex = temp_v;
-		a_star_queue[i].heuristic = euclideanDist(temp_v, target);
+		a_star_queue[i].heuristic = heuristic_dist(heuristic, temp_v,
+							   target);
 
 		if (strcmp(start->content, temp_v->content) == 0)
 			a_star_queue[i].cml_weight = 0;
@@ -262,4 +264,23 @@ queue_t *a_star_graph(graph_t *graph, vertex_t const *start,
 	path = pathFromAStarQueue(a_star_queue, target_i);
 	free(a_star_queue);
 	return (path);
+}
+
+
+/**
+  * a_star_graph - searches for the shortest and fastest path from a starting
+  *   point to a target point in a graph, using the A* algorithm with Euclidean
+  *   distance between vertex and target as the additional heuristic
+  *
+  * @graph: pointer to the graph to traverse
+  * @start: pointer to starting vertex
+  * @target: pointer to target vertex
+  * Return: returns a queue in which each node is a `char *` corresponding to a
+  *   vertex, forming a path from start to target, or NULL on failure
+  */
+queue_t *a_star_graph(graph_t *graph, vertex_t const *start,
+		      vertex_t const *target)
+{
+	return (a_star_graph_heuristic(graph, start, target,
+				       HEURISTIC_EUCLIDEAN));
 }
\ No newline at end of file
@@ -131,6 +131,7 @@ vertex_t *graph_add_vertex(graph_t *graph, char const *str, int x, int y)
         return NULL;
     }
     
+    new_vertex->index = graph->nb_vertices;
     new_vertex->x = x;
     new_vertex->y = y;
     new_vertex->nb_edges = 0;
@@ -149,8 +150,6 @@ int graph_add_edge(graph_t *graph, char const *src,
     vertex_t *vertex;
     edge_t *new_edge;
     
-    (void)type; /* Type parameter is ignored since edge_t has no type member */
-    
     if (!graph || !src || !dest)
         return 0;
     
@@ -181,6 +180,10 @@ int graph_add_edge(graph_t *graph, char const *src,
     src_vertex->edges = new_edge;
     src_vertex->nb_edges++;
     
+    /* Bidirectional connections are made of two edges */
+    if (type == BIDIRECTIONAL && src_vertex != dest_vertex)
+        return graph_add_edge(graph, dest, src, weight, UNIDIRECTIONAL);
+    
     return 1;
 }
 
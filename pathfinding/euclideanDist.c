@@ -1,55 +1,170 @@
 #include "pathfinding.h"
-/* fprintf */
-#include <stdio.h>
 /* sqrt */
 #include <math.h>
 
-#define ABS(x)    ((x) > 0 ? (x) : -(x))
-#define MIN(a, b) ((a) < (b) ? (a) : (b))
-#define MAX(a, b) ((a) > (b) ? (a) : (b))
+/* branch-free absolute value, minimum and maximum of longs */
+#define SIGN_SHIFT (sizeof(long) * 8 - 1)
+#define ABS(x)    (((x) ^ ((x) >> SIGN_SHIFT)) - ((x) >> SIGN_SHIFT))
+#define MIN(a, b) ((b) ^ (((a) ^ (b)) & -(long)((a) < (b))))
+#define MAX(a, b) ((a) ^ (((a) ^ (b)) & -(long)((a) < (b))))
 
+/* 256 * (sqrt(2) - 1), extra cost of a diagonal step over a straight one */
+#define OCTILE_DIAG 106
+
+#define HEURISTIC_LANES 4
 
 /**
-  * euclideanDist - calculates the distance between two point in a coordinate
-  *   grid, defined as the hypoteneuse of the differences in their x and y
-  *   values
+  * heur_vec_t - vector of long lanes (GCC vector extension); operations on
+  *   it compile to SIMD instructions where the target has them
+  */
+typedef long heur_vec_t __attribute__((vector_size(HEURISTIC_LANES *
+						 sizeof(long))));
+
+
+/**
+  * heuristicFromDeltas - combines absolute coordinate differences into the
+  *   chosen distance, without branching on the coordinates
+  *
+  * @heuristic: distance to compute
+  * @dx: absolute difference of X coordinates
+  * @dy: absolute difference of Y coordinates
+  * Return: distance in grid units, rounded down
+  */
+static size_t heuristicFromDeltas(heuristic_t heuristic, long dx, long dy)
+{
+	switch (heuristic)
+	{
+	case HEURISTIC_MANHATTAN:
+		return (dx + dy);
+	case HEURISTIC_OCTILE:
+		return (MAX(dx, dy) + ((MIN(dx, dy) * OCTILE_DIAG) >> 8));
+	case HEURISTIC_CHEBYSHEV:
+		return (MAX(dx, dy));
+	case HEURISTIC_EUCLIDEAN_SQ:
+		return (dx * dx + dy * dy);
+	case HEURISTIC_EUCLIDEAN:
+		return ((size_t)sqrt((double)(dx * dx + dy * dy)));
+	default:
+		return (0);
+	}
+}
+
+
+/**
+  * heuristic_dist - calculates the distance between two vertices with the
+  *   chosen heuristic
   *
+  * @heuristic: distance to compute
   * @vertex: pointer to starting vertex
   * @target: pointer to target vertex
   * Return: distance between the two points in grid units, rounded down to
-  *   nearest integer, or 0 on failure (with message)
+  *   nearest integer
   */
-size_t euclideanDist(const vertex_t *vertex, const vertex_t *target)
+size_t heuristic_dist(heuristic_t heuristic, const vertex_t *vertex,
+		      const vertex_t *target)
+{
+	long dx = (long)vertex->x - target->x, dy = (long)vertex->y - target->y;
+
+	return (heuristicFromDeltas(heuristic, ABS(dx), ABS(dy)));
+}
+
+
+/**
+  * heuristic_batch - calculates the distance from many points to one target
+  *   point, HEURISTIC_LANES points at a time with SIMD
+  *
+  * @heuristic: distance to compute
+  * @xs: X coordinates of the points
+  * @ys: Y coordinates of the points
+  * @n: amount of points
+  * @target: pointer to target vertex
+  * @out: receives the distance of each point, rounded down
+  */
+void heuristic_batch(heuristic_t heuristic, const int *xs, const int *ys,
+		     size_t n, const vertex_t *target, size_t *out)
 {
-	int dx, dy;
-	double hyp;
+	heur_vec_t dx, dy, lt, lo, hi, r;
+	size_t i = 0, j;
 
-	if (!vertex || !target)
+	for (; i + HEURISTIC_LANES <= n; i += HEURISTIC_LANES)
 	{
-		fprintf(stderr, "euclideanDist: NULL parameters\n");
-		return (0);
+		for (j = 0; j < HEURISTIC_LANES; j++)
+		{
+			dx[j] = (long)xs[i + j] - target->x;
+			dy[j] = (long)ys[i + j] - target->y;
+		}
+		dx = ABS(dx);
+		dy = ABS(dy);
+		lt = dx < dy;
+		lo = (dx & lt) | (dy & ~lt);
+		hi = (dy & lt) | (dx & ~lt);
+		if (heuristic == HEURISTIC_MANHATTAN)
+			r = dx + dy;
+		else if (heuristic == HEURISTIC_OCTILE)
+			r = hi + ((lo * OCTILE_DIAG) >> 8);
+		else if (heuristic == HEURISTIC_CHEBYSHEV)
+			r = hi;
+		else if (heuristic == HEURISTIC_EUCLIDEAN_SQ ||
+			 heuristic == HEURISTIC_EUCLIDEAN)
+			r = dx * dx + dy * dy;
+		else
+			r = dx ^ dx;
+		for (j = 0; j < HEURISTIC_LANES; j++)
+			out[i + j] = heuristic == HEURISTIC_EUCLIDEAN ?
+				(size_t)sqrt((double)r[j]) : (size_t)r[j];
 	}
+	for (; i < n; i++)
+		out[i] = heuristicFromDeltas(heuristic,
+					     ABS((long)xs[i] - target->x),
+					     ABS((long)ys[i] - target->y));
+}
+
+
+/**
+  * heuristic_edges - calculates the distance from the destination of every
+  *   edge of a vertex to a target vertex, in adjacency list order
+  *
+  * @heuristic: distance to compute
+  * @vertex: pointer to the vertex whose edges are evaluated
+  * @target: pointer to target vertex
+  * @out: receives the distance of each edge's destination
+  * @max: length of @out
+  * Return: amount of distances stored, at most @max
+  */
+size_t heuristic_edges(heuristic_t heuristic, const vertex_t *vertex,
+		       const vertex_t *target, size_t *out, size_t max)
+{
+	int xs[64], ys[64];
+	const edge_t *edge = vertex->edges;
+	size_t n = 0, chunk;
 
-	if ((vertex->x >= 0 && target->x >= 0) ||
-	    (vertex->x < 0 && target->x < 0))
-		dx = MAX(ABS(vertex->x), ABS(target->x)) -
-			MIN(ABS(vertex->x), ABS(target->x));
-	else
-		dx = ABS(vertex->x) + ABS(target->x);
-
-	if ((vertex->y >= 0 && target->y >= 0) ||
-	    (vertex->y < 0 && target->y < 0))
-		dy = MAX(ABS(vertex->y), ABS(target->y)) -
-			MIN(ABS(vertex->y), ABS(target->y));
-	else
-		dy = ABS(vertex->y) + ABS(target->y);
-
-	hyp = sqrt((dx * dx) + (dy * dy));
-	if (!isfinite(hyp))
+	while (edge && n < max)
 	{
-		fprintf(stderr, "euclideanDist: square root is not finite\n");
-		return (0);
+		for (chunk = 0; edge && chunk < 64 && n + chunk < max;
+		     chunk++, edge = edge->next)
+		{
+			xs[chunk] = edge->dest->x;
+			ys[chunk] = edge->dest->y;
+		}
+		heuristic_batch(heuristic, xs, ys, chunk, target, out + n);
+		n += chunk;
 	}
 
-	return ((size_t)hyp);
-}
\ No newline at end of file
+	return (n);
+}
+
+
+/**
+  * euclideanDist - calculates the distance between two point in a coordinate
+  *   grid, defined as the hypoteneuse of the differences in their x and y
+  *   values
+  *
+  * @vertex: pointer to starting vertex
+  * @target: pointer to target vertex
+  * Return: distance between the two points in grid units, rounded down to
+  *   nearest integer
+  */
+size_t euclideanDist(const vertex_t *vertex, const vertex_t *target)
+{
+	return (heuristic_dist(HEURISTIC_EUCLIDEAN, vertex, target));
+}
@@ -0,0 +1,178 @@
+#include "pathfinding.h"
+/* malloc calloc free */
+#include <stdlib.h>
+
+
+/**
+  * graph_csr_delete - deallocates a compressed snapshot of a graph
+  *
+  * @csr: pointer to the snapshot to delete
+  */
+void graph_csr_delete(graph_csr_t *csr)
+{
+	if (!csr)
+		return;
+
+	free(csr->vertices);
+	free(csr->off);
+	free(csr->src);
+	free(csr->dest);
+	free(csr->weight);
+	free(csr->edge_mask);
+	free(csr->vertex_mask);
+	free(csr->dist);
+	free(csr->via);
+	free(csr->stamp);
+	index_heap_delete(csr->open);
+	free(csr);
+}
+
+
+/**
+  * csrFillEdges - copies the graph's adjacency lists into the flat edge
+  *   arrays of a snapshot, grouped by source vertex index
+  *
+  * @csr: pointer to a snapshot with every array allocated
+  * @graph: pointer to the graph
+  * Return: 1 on success, 0 if vertex indices are inconsistent
+  */
+static int csrFillEdges(graph_csr_t *csr, graph_t *graph)
+{
+	vertex_t *v = NULL;
+	edge_t *e = NULL;
+	size_t i, j;
+
+	for (v = graph->vertices; v; v = v->next)
+	{
+		if (v->index >= csr->nb_vertices || csr->vertices[v->index])
+			return (0);
+		csr->vertices[v->index] = v;
+	}
+	for (i = 0, j = 0; i < csr->nb_vertices; i++)
+	{
+		csr->off[i] = j;
+		for (e = csr->vertices[i]->edges; e; e = e->next, j++)
+		{
+			csr->src[j] = i;
+			csr->dest[j] = e->dest->index;
+			csr->weight[j] = e->weight < 0 ? 0 : (size_t)e->weight;
+		}
+	}
+	csr->off[i] = j;
+
+	return (1);
+}
+
+
+/**
+  * graph_csr_create - takes a compressed sparse row snapshot of a graph,
+  *   with per vertex and per edge masks and a search workspace shared by
+  *   every dijkstra_csr() call on it; later changes to the graph are not
+  *   reflected in the snapshot
+  *
+  * @graph: pointer to the graph
+  * Return: pointer to the new snapshot, or NULL on failure
+  */
+graph_csr_t *graph_csr_create(graph_t *graph)
+{
+	graph_csr_t *csr = NULL;
+	vertex_t *v = NULL;
+	size_t n, m = 0;
+
+	if (!graph || !graph->nb_vertices || !graph->vertices)
+		return (NULL);
+
+	for (v = graph->vertices; v; v = v->next)
+		m += v->nb_edges;
+	n = graph->nb_vertices;
+	csr = calloc(1, sizeof(graph_csr_t));
+	if (!csr)
+		return (NULL);
+	csr->nb_vertices = n;
+	csr->nb_edges = m;
+	csr->vertices = calloc(n, sizeof(vertex_t *));
+	csr->off = malloc(sizeof(size_t) * (n + 1));
+	csr->src = malloc(sizeof(size_t) * (m + 1));
+	csr->dest = malloc(sizeof(size_t) * (m + 1));
+	csr->weight = malloc(sizeof(size_t) * (m + 1));
+	csr->edge_mask = calloc(m + 1, sizeof(unsigned char));
+	csr->vertex_mask = calloc(n, sizeof(unsigned char));
+	csr->dist = malloc(sizeof(size_t) * n);
+	csr->via = malloc(sizeof(size_t) * n);
+	csr->stamp = calloc(n, sizeof(size_t));
+	csr->open = index_heap_create(n);
+	if (!csr->vertices || !csr->off || !csr->src || !csr->dest ||
+	    !csr->weight || !csr->edge_mask || !csr->vertex_mask ||
+	    !csr->dist || !csr->via || !csr->stamp || !csr->open ||
+	    !csrFillEdges(csr, graph))
+	{
+		graph_csr_delete(csr);
+		return (NULL);
+	}
+
+	return (csr);
+}
+
+
+/**
+  * csrReach - records a tentative distance for a vertex reached during the
+  *   current search, lazily resetting vertices not yet seen by it
+  *
+  * @csr: pointer to the snapshot
+  * @v: index of the reached vertex
+  * @dist: tentative distance from the start
+  * @via: index of the edge used to reach @v, or CSR_NONE
+  */
+static void csrReach(graph_csr_t *csr, size_t v, size_t dist, size_t via)
+{
+	if (csr->stamp[v] == csr->generation && csr->dist[v] <= dist)
+		return;
+
+	csr->stamp[v] = csr->generation;
+	csr->dist[v] = dist;
+	csr->via[v] = via;
+	index_heap_push(csr->open, v, dist, 0);
+}
+
+
+/**
+  * dijkstra_csr - searches a snapshot for the shortest path between two
+  *   vertices, skipping masked vertices and edges. Nothing is allocated and
+  *   nothing is reset in O(V): vertices are stamped with a search generation.
+  *   On success the path can be read backwards from @target through
+  *   csr->via (edge indices) and csr->src.
+  *
+  * @csr: pointer to the snapshot
+  * @start: index of the starting vertex
+  * @target: index of the target vertex
+  * Return: cost of the shortest path, or CSR_INF if @target is unreachable
+  */
+size_t dijkstra_csr(graph_csr_t *csr, size_t start, size_t target)
+{
+	size_t u, i, d;
+
+	if (!csr || start >= csr->nb_vertices || target >= csr->nb_vertices ||
+	    csr->vertex_mask[start] || csr->vertex_mask[target])
+		return (CSR_INF);
+
+	while (csr->open->size)
+		index_heap_pop(csr->open);
+	csr->generation++;
+	csrReach(csr, start, 0, CSR_NONE);
+	while ((u = index_heap_pop(csr->open)) != INDEX_HEAP_NONE)
+	{
+		if (u == target)
+			return (csr->dist[u]);
+		for (i = csr->off[u]; i < csr->off[u + 1]; i++)
+		{
+			if (csr->edge_mask[i] || csr->vertex_mask[csr->dest[i]])
+				continue;
+			d = csr->dist[u] + csr->weight[i];
+			if (d < csr->dist[u])
+				continue;
+			csrReach(csr, csr->dest[i], d, i);
+		}
+	}
+
+	return (CSR_INF);
+}
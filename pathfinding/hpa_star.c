@@ -0,0 +1,832 @@
+#include "pathfinding.h"
+/* malloc calloc realloc free */
+#include <stdlib.h>
+/* sprintf */
+#include <stdio.h>
+/* strdup */
+#include <string.h>
+
+/* entrances at least this wide get a transition at each end */
+#define HPA_WIDE_ENTRANCE 6
+
+#define HPA_EAST 0
+#define HPA_SOUTH 1
+
+
+/**
+  * hpaWalkable - tells whether a map cell can be stepped on
+  *
+  * @hpa: pointer to the hierarchical map
+  * @x: X coordinate of the cell
+  * @y: Y coordinate of the cell
+  * Return: 1 if the cell is inside the map and not blocked, 0 otherwise
+  */
+static int hpaWalkable(const hpa_t *hpa, int x, int y)
+{
+	return (x >= 0 && y >= 0 && x < hpa->cols && y < hpa->rows &&
+		hpa->map[y][x] != '1');
+}
+
+
+/**
+  * hpaCluster - finds the cluster holding a cell
+  *
+  * @hpa: pointer to the hierarchical map
+  * @x: X coordinate of the cell
+  * @y: Y coordinate of the cell
+  * Return: index of the cluster
+  */
+static size_t hpaCluster(const hpa_t *hpa, int x, int y)
+{
+	return ((size_t)(y / hpa->size) * hpa->cl_cols + x / hpa->size);
+}
+
+
+/**
+  * hpaEdgeAdd - connects a vertex of the abstract graph to another
+  *
+  * @from: vertex the edge starts from
+  * @to: vertex the edge leads to
+  * @weight: weight of the edge
+  * Return: 1 on success, 0 on failure
+  */
+static int hpaEdgeAdd(vertex_t *from, vertex_t *to, int weight)
+{
+	edge_t *edge = malloc(sizeof(edge_t));
+
+	if (!edge)
+		return (0);
+
+	edge->dest = to;
+	edge->weight = weight;
+	edge->next = from->edges;
+	from->edges = edge;
+	from->nb_edges++;
+
+	return (1);
+}
+
+
+/**
+  * hpaEdgesRemove - removes edges of an abstract vertex: every edge leading
+  *   to @to, or if @to is NULL, every edge leading into cluster @k or to a
+  *   retired node
+  *
+  * @hpa: pointer to the hierarchical map
+  * @from: vertex whose edges are removed
+  * @to: destination of the edges to remove, or NULL
+  * @k: cluster whose intra-cluster edges are removed when @to is NULL
+  */
+static void hpaEdgesRemove(hpa_t *hpa, vertex_t *from, const vertex_t *to,
+			   size_t k)
+{
+	edge_t **link = &from->edges, *edge = NULL;
+	size_t c;
+
+	while (*link)
+	{
+		edge = *link;
+		c = hpa->nodes[edge->dest->index].cluster;
+		if (to ? edge->dest == to : (c == k || c == HPA_NONE))
+		{
+			*link = edge->next;
+			from->nb_edges--;
+			free(edge);
+		}
+		else
+			link = &edge->next;
+	}
+}
+
+
+/**
+  * hpaNewSlot - grows the node arrays by one node, with a new vertex at the
+  *   head of the abstract graph
+  *
+  * @hpa: pointer to the hierarchical map
+  * Return: index of the new node and vertex, or HPA_NONE on failure
+  */
+static size_t hpaNewSlot(hpa_t *hpa)
+{
+	size_t cap = hpa->cap ? hpa->cap * 2 : 64, *free_slots, *retired;
+	hpa_node_t *nodes = NULL;
+	vertex_t *v = NULL;
+
+	if (hpa->nb_nodes == hpa->cap)
+	{
+		nodes = realloc(hpa->nodes, sizeof(hpa_node_t) * cap);
+		if (nodes)
+			hpa->nodes = nodes;
+		free_slots = realloc(hpa->free, sizeof(size_t) * cap);
+		if (free_slots)
+			hpa->free = free_slots;
+		retired = realloc(hpa->retired, sizeof(size_t) * cap);
+		if (retired)
+			hpa->retired = retired;
+		if (!nodes || !free_slots || !retired)
+			return (HPA_NONE);
+		hpa->cap = cap;
+	}
+	v = calloc(1, sizeof(vertex_t));
+	if (!v)
+		return (HPA_NONE);
+	v->index = hpa->nb_nodes;
+	v->next = hpa->abstract->vertices;
+	hpa->abstract->vertices = v;
+	hpa->abstract->nb_vertices++;
+	hpa->nodes[hpa->nb_nodes].vertex = v;
+	hpa->nodes[hpa->nb_nodes].cluster = HPA_NONE;
+
+	return (hpa->nb_nodes++);
+}
+
+
+/**
+  * hpaNode - finds the abstract node of a cell in a cluster, creating it
+  *   (reusing a free vertex of the abstract graph if possible) if it does
+  *   not exist yet
+  *
+  * @hpa: pointer to the hierarchical map
+  * @k: index of the cluster holding the cell
+  * @x: X coordinate of the cell
+  * @y: Y coordinate of the cell
+  * Return: index of the node (and of its vertex), or HPA_NONE on failure
+  */
+static size_t hpaNode(hpa_t *hpa, size_t k, int x, int y)
+{
+	hpa_cluster_t *cl = hpa->clusters + k;
+	vertex_t *v = NULL;
+	size_t i, *grown = NULL;
+	char name[32];
+
+	for (i = 0; i < cl->nb_nodes; i++)
+	{
+		v = hpa->nodes[cl->nodes[i]].vertex;
+		if (v->x == x && v->y == y)
+			return (cl->nodes[i]);
+	}
+	if (cl->nb_nodes == cl->cap_nodes)
+	{
+		grown = realloc(cl->nodes, sizeof(size_t) *
+				(cl->cap_nodes ? cl->cap_nodes * 2 : 4));
+		if (!grown)
+			return (HPA_NONE);
+		cl->nodes = grown;
+		cl->cap_nodes = cl->cap_nodes ? cl->cap_nodes * 2 : 4;
+	}
+	i = hpa->nb_free ? hpa->free[--hpa->nb_free] : hpaNewSlot(hpa);
+	if (i == HPA_NONE)
+		return (HPA_NONE);
+
+	v = hpa->nodes[i].vertex;
+	sprintf(name, "%d,%d", x, y);
+	free(v->content);
+	v->content = strdup(name);
+	if (!v->content)
+	{
+		hpa->free[hpa->nb_free++] = i;
+		return (HPA_NONE);
+	}
+	v->x = x;
+	v->y = y;
+	hpa->nodes[i].cluster = k;
+	hpa->nodes[i].refs = 0;
+	cl->nodes[cl->nb_nodes++] = i;
+
+	return (i);
+}
+
+
+/**
+  * hpaRetire - removes a node from its cluster and frees its edges; its
+  *   vertex stays in the abstract graph, edgeless, until it is reused
+  *
+  * @hpa: pointer to the hierarchical map
+  * @i: index of the node
+  * @reusable: 1 if no other vertex has an edge to this one any more, so it
+  *   can be reused right away; 0 to defer reuse until the cluster has been
+  *   relinked by hpaClusterLink()
+  */
+static void hpaRetire(hpa_t *hpa, size_t i, int reusable)
+{
+	hpa_cluster_t *cl = hpa->clusters + hpa->nodes[i].cluster;
+	vertex_t *v = hpa->nodes[i].vertex;
+	edge_t *edge = NULL;
+	size_t j;
+
+	for (j = 0; j < cl->nb_nodes && cl->nodes[j] != i; j++)
+		;
+	if (j < cl->nb_nodes)
+		cl->nodes[j] = cl->nodes[--cl->nb_nodes];
+	while (v->edges)
+	{
+		edge = v->edges;
+		v->edges = edge->next;
+		free(edge);
+	}
+	v->nb_edges = 0;
+	hpa->nodes[i].cluster = HPA_NONE;
+	if (reusable)
+		hpa->free[hpa->nb_free++] = i;
+	else
+		hpa->retired[hpa->nb_retired++] = i;
+}
+
+
+/**
+  * hpaBfs - breadth-first search from a cell, restricted to its cluster;
+  *   fills hpa->dist (-1 where unreachable) and hpa->from (previous cell)
+  *   for every cell of the cluster, indexed relative to its top left corner
+  *
+  * @hpa: pointer to the hierarchical map
+  * @k: index of the cluster holding the cell
+  * @x: X coordinate of the cell
+  * @y: Y coordinate of the cell
+  */
+static void hpaBfs(hpa_t *hpa, size_t k, int x, int y)
+{
+	int x0 = (int)(k % hpa->cl_cols) * hpa->size;
+	int y0 = (int)(k / hpa->cl_cols) * hpa->size;
+	int dx[4] = {1, 0, -1, 0}, dy[4] = {0, 1, 0, -1};
+	int head = 0, tail = 0, c, nx, ny, n, d, s = hpa->size;
+
+	for (c = 0; c < s * s; c++)
+		hpa->dist[c] = -1;
+	c = (y - y0) * s + (x - x0);
+	hpa->dist[c] = 0;
+	hpa->from[c] = -1;
+	hpa->bfs[tail++] = c;
+	while (head < tail)
+	{
+		c = hpa->bfs[head++];
+		for (d = 0; d < 4; d++)
+		{
+			nx = x0 + c % s + dx[d];
+			ny = y0 + c / s + dy[d];
+			if (nx < x0 || ny < y0 || nx >= x0 + s ||
+			    ny >= y0 + s || !hpaWalkable(hpa, nx, ny))
+				continue;
+			n = (ny - y0) * s + (nx - x0);
+			if (hpa->dist[n] >= 0)
+				continue;
+			hpa->dist[n] = hpa->dist[c] + 1;
+			hpa->from[n] = c;
+			hpa->bfs[tail++] = n;
+		}
+	}
+}
+
+
+/**
+  * hpaClusterLink - replaces the intra-cluster edges of a cluster's nodes
+  *   with the current shortest distances between them inside the cluster
+  *
+  * @hpa: pointer to the hierarchical map
+  * @k: index of the cluster
+  * Return: 1 on success, 0 on failure
+  */
+static int hpaClusterLink(hpa_t *hpa, size_t k)
+{
+	hpa_cluster_t *cl = hpa->clusters + k;
+	int x0 = (int)(k % hpa->cl_cols) * hpa->size;
+	int y0 = (int)(k / hpa->cl_cols) * hpa->size;
+	vertex_t *u = NULL, *v = NULL;
+	size_t i, j;
+	int d;
+
+	for (i = 0; i < cl->nb_nodes; i++)
+		hpaEdgesRemove(hpa, hpa->nodes[cl->nodes[i]].vertex, NULL, k);
+	for (i = 0; i < cl->nb_nodes; i++)
+	{
+		u = hpa->nodes[cl->nodes[i]].vertex;
+		hpaBfs(hpa, k, u->x, u->y);
+		for (j = 0; j < cl->nb_nodes; j++)
+		{
+			v = hpa->nodes[cl->nodes[j]].vertex;
+			d = hpa->dist[(v->y - y0) * hpa->size + (v->x - x0)];
+			if (i != j && d > 0 && !hpaEdgeAdd(u, v, d))
+				return (0);
+		}
+	}
+
+	return (1);
+}
+
+
+/**
+  * hpaBorderClear - removes the transitions across one border of a cluster,
+  *   retiring the nodes no other transition uses
+  *
+  * @hpa: pointer to the hierarchical map
+  * @k: index of the cluster
+  * @dir: HPA_EAST or HPA_SOUTH
+  */
+static void hpaBorderClear(hpa_t *hpa, size_t k, int dir)
+{
+	hpa_cluster_t *cl = hpa->clusters + k;
+	hpa_transition_t *t = NULL;
+	size_t i;
+
+	for (i = 0; i < cl->nb_border[dir]; i++)
+	{
+		t = cl->border[dir] + i;
+		hpaEdgesRemove(hpa, hpa->nodes[t->a].vertex,
+			       hpa->nodes[t->b].vertex, 0);
+		hpaEdgesRemove(hpa, hpa->nodes[t->b].vertex,
+			       hpa->nodes[t->a].vertex, 0);
+		if (--hpa->nodes[t->a].refs == 0)
+			hpaRetire(hpa, t->a, 0);
+		if (--hpa->nodes[t->b].refs == 0)
+			hpaRetire(hpa, t->b, 0);
+	}
+	cl->nb_border[dir] = 0;
+}
+
+
+/**
+  * hpaTransition - adds a transition between two adjacent cells on either
+  *   side of a border, as two abstract nodes joined by edges of weight 1
+  *
+  * @hpa: pointer to the hierarchical map
+  * @k: index of the cluster on the west or north side of the border
+  * @dir: HPA_EAST or HPA_SOUTH
+  * @x: X coordinate of the cell on the @k side
+  * @y: Y coordinate of the cell on the @k side
+  * Return: 1 on success, 0 on failure
+  */
+static int hpaTransition(hpa_t *hpa, size_t k, int dir, int x, int y)
+{
+	hpa_cluster_t *cl = hpa->clusters + k;
+	hpa_transition_t *grown = NULL, t;
+	size_t cap = cl->cap_border[dir] ? cl->cap_border[dir] * 2 : 2;
+
+	t.a = hpaNode(hpa, k, x, y);
+	t.b = dir == HPA_EAST ? hpaNode(hpa, k + 1, x + 1, y) :
+		hpaNode(hpa, k + hpa->cl_cols, x, y + 1);
+	if (t.a == HPA_NONE || t.b == HPA_NONE)
+		return (0);
+	if (cl->nb_border[dir] == cl->cap_border[dir])
+	{
+		grown = realloc(cl->border[dir],
+				sizeof(hpa_transition_t) * cap);
+		if (!grown)
+			return (0);
+		cl->border[dir] = grown;
+		cl->cap_border[dir] = cap;
+	}
+	if (!hpaEdgeAdd(hpa->nodes[t.a].vertex, hpa->nodes[t.b].vertex, 1) ||
+	    !hpaEdgeAdd(hpa->nodes[t.b].vertex, hpa->nodes[t.a].vertex, 1))
+		return (0);
+	hpa->nodes[t.a].refs++;
+	hpa->nodes[t.b].refs++;
+	cl->border[dir][cl->nb_border[dir]++] = t;
+
+	return (1);
+}
+
+
+/**
+  * hpaBorderBuild - finds the entrances across one border of a cluster
+  *   (maximal runs of cells walkable on both sides) and adds one transition
+  *   in the middle of narrow entrances, one at each end of wide ones
+  *
+  * @hpa: pointer to the hierarchical map
+  * @k: index of the cluster
+  * @dir: HPA_EAST or HPA_SOUTH
+  * Return: 1 on success, 0 on failure
+  */
+static int hpaBorderBuild(hpa_t *hpa, size_t k, int dir)
+{
+	int cx = (int)(k % hpa->cl_cols), cy = (int)(k / hpa->cl_cols);
+	int i, lo, hi, run = -1, mid, open, x, y, ok = 1;
+
+	if ((dir == HPA_EAST && cx + 1 >= (int)hpa->cl_cols) ||
+	    (dir == HPA_SOUTH && cy + 1 >= (int)hpa->cl_rows))
+		return (1);
+	lo = (dir == HPA_EAST ? cy : cx) * hpa->size;
+	hi = lo + hpa->size;
+	if (hi > (dir == HPA_EAST ? hpa->rows : hpa->cols))
+		hi = dir == HPA_EAST ? hpa->rows : hpa->cols;
+	for (i = lo; ok && i <= hi; i++)
+	{
+		x = dir == HPA_EAST ? (cx + 1) * hpa->size - 1 : i;
+		y = dir == HPA_EAST ? i : (cy + 1) * hpa->size - 1;
+		open = i < hi && hpaWalkable(hpa, x, y) &&
+			hpaWalkable(hpa, x + (dir == HPA_EAST),
+				    y + (dir == HPA_SOUTH));
+		if (open && run < 0)
+			run = i;
+		if (open || run < 0)
+			continue;
+		mid = run + (i - run) / 2;
+		if (i - run < HPA_WIDE_ENTRANCE)
+			ok = dir == HPA_EAST ?
+				hpaTransition(hpa, k, dir, x, mid) :
+				hpaTransition(hpa, k, dir, mid, y);
+		else
+			ok = dir == HPA_EAST ?
+				hpaTransition(hpa, k, dir, x, run) &&
+				hpaTransition(hpa, k, dir, x, i - 1) :
+				hpaTransition(hpa, k, dir, run, y) &&
+				hpaTransition(hpa, k, dir, i - 1, y);
+		run = -1;
+	}
+
+	return (ok);
+}
+
+
+/**
+  * hpaTempRemove - removes a temporary query node and every edge to it
+  *
+  * @hpa: pointer to the hierarchical map
+  * @i: index of the node
+  */
+static void hpaTempRemove(hpa_t *hpa, size_t i)
+{
+	hpa_cluster_t *cl = hpa->clusters + hpa->nodes[i].cluster;
+	size_t j;
+
+	for (j = 0; j < cl->nb_nodes; j++)
+		hpaEdgesRemove(hpa, hpa->nodes[cl->nodes[j]].vertex,
+			       hpa->nodes[i].vertex, 0);
+	hpaRetire(hpa, i, 1);
+}
+
+
+/**
+  * hpaTempNode - connects a query cell to the abstract graph: unless it is
+  *   already a transition cell, adds a temporary node linked both ways to
+  *   every node of its cluster it can reach inside the cluster
+  *
+  * @hpa: pointer to the hierarchical map
+  * @p: coordinates of the cell
+  * @created: set to 1 if a temporary node was added, to be removed with
+  *   hpaTempRemove() after the query, 0 otherwise
+  * Return: index of the cell's node, or HPA_NONE on failure
+  */
+static size_t hpaTempNode(hpa_t *hpa, const point_t *p, int *created)
+{
+	size_t k = hpaCluster(hpa, p->x, p->y), before, i, j;
+	hpa_cluster_t *cl = hpa->clusters + k;
+	int x0 = (int)(k % hpa->cl_cols) * hpa->size;
+	int y0 = (int)(k / hpa->cl_cols) * hpa->size, d;
+	vertex_t *u = NULL, *v = NULL;
+
+	before = cl->nb_nodes;
+	i = hpaNode(hpa, k, p->x, p->y);
+	*created = i != HPA_NONE && cl->nb_nodes > before;
+	if (!*created)
+		return (i);
+
+	u = hpa->nodes[i].vertex;
+	hpaBfs(hpa, k, p->x, p->y);
+	for (j = 0; j < cl->nb_nodes; j++)
+	{
+		v = hpa->nodes[cl->nodes[j]].vertex;
+		d = hpa->dist[(v->y - y0) * hpa->size + (v->x - x0)];
+		if (v != u && d > 0 &&
+		    (!hpaEdgeAdd(u, v, d) || !hpaEdgeAdd(v, u, d)))
+		{
+			hpaTempRemove(hpa, i);
+			*created = 0;
+			return (HPA_NONE);
+		}
+	}
+
+	return (i);
+}
+
+
+/**
+  * hpaSearch - A* search over the abstract graph, with the Manhattan
+  *   distance as heuristic; the path can then be read backwards from @t
+  *   through hpa->via
+  *
+  * @hpa: pointer to the hierarchical map
+  * @s: index of the start node
+  * @t: index of the target node
+  * Return: 1 if a path was found, 0 otherwise or on failure
+  */
+static int hpaSearch(hpa_t *hpa, size_t s, size_t t)
+{
+	const vertex_t *target = hpa->nodes[t].vertex;
+	edge_t *e = NULL;
+	size_t u, v, d, old = hpa->open ? hpa->open->capacity : 0;
+	size_t *g, *via, *stamp;
+	index_heap_t *open;
+
+	if (old < hpa->cap)
+	{
+		open = index_heap_create(hpa->cap);
+		g = realloc(hpa->g, sizeof(size_t) * hpa->cap);
+		if (g)
+			hpa->g = g;
+		via = realloc(hpa->via, sizeof(size_t) * hpa->cap);
+		if (via)
+			hpa->via = via;
+		stamp = realloc(hpa->stamp, sizeof(size_t) * hpa->cap);
+		if (stamp)
+			hpa->stamp = stamp;
+		if (!open || !g || !via || !stamp)
+		{
+			index_heap_delete(open);
+			return (0);
+		}
+		memset(hpa->stamp + old, 0, sizeof(size_t) * (hpa->cap - old));
+		index_heap_delete(hpa->open);
+		hpa->open = open;
+	}
+	while (hpa->open->size)
+		index_heap_pop(hpa->open);
+	hpa->generation++;
+	hpa->stamp[s] = hpa->generation;
+	hpa->g[s] = 0;
+	hpa->via[s] = HPA_NONE;
+	index_heap_push(hpa->open, s, 0, 0);
+	while ((u = index_heap_pop(hpa->open)) != INDEX_HEAP_NONE)
+	{
+		if (u == t)
+			return (1);
+		for (e = hpa->nodes[u].vertex->edges; e; e = e->next)
+		{
+			v = e->dest->index;
+			d = hpa->g[u] + e->weight;
+			if (hpa->stamp[v] == hpa->generation && hpa->g[v] <= d)
+				continue;
+			hpa->stamp[v] = hpa->generation;
+			hpa->g[v] = d;
+			hpa->via[v] = u;
+			index_heap_push(hpa->open, v, d +
+					heuristic_dist(HEURISTIC_MANHATTAN,
+						       e->dest, target), d);
+		}
+	}
+
+	return (0);
+}
+
+
+/**
+  * hpaPushCell - adds a map cell at the front of a path
+  *
+  * @path: queue of point_t
+  * @x: X coordinate of the cell
+  * @y: Y coordinate of the cell
+  * Return: 1 on success, 0 on failure
+  */
+static int hpaPushCell(queue_t *path, int x, int y)
+{
+	point_t *p = malloc(sizeof(point_t));
+
+	if (!p)
+		return (0);
+	p->x = x;
+	p->y = y;
+	if (!queue_push_front(path, p))
+	{
+		free(p);
+		return (0);
+	}
+
+	return (1);
+}
+
+
+/**
+  * hpaRefine - turns the abstract path found by hpaSearch() into map cells,
+  *   by searching again inside each cluster crossed, from the cell it was
+  *   entered at to the cell it was left from
+  *
+  * @hpa: pointer to the hierarchical map
+  * @path: empty queue, receives the cells of the path
+  * @t: index of the target node
+  * Return: 1 on success, 0 on failure
+  */
+static int hpaRefine(hpa_t *hpa, queue_t *path, size_t t)
+{
+	vertex_t *a = NULL, *b = hpa->nodes[t].vertex;
+	size_t u, v, k;
+	int c, x0, y0;
+
+	if (!hpaPushCell(path, b->x, b->y))
+		return (0);
+	for (v = t; (u = hpa->via[v]) != HPA_NONE; v = u)
+	{
+		a = hpa->nodes[u].vertex;
+		b = hpa->nodes[v].vertex;
+		k = hpa->nodes[u].cluster;
+		if (k != hpa->nodes[v].cluster)
+		{
+			if (!hpaPushCell(path, a->x, a->y))
+				return (0);
+			continue;
+		}
+		x0 = (int)(k % hpa->cl_cols) * hpa->size;
+		y0 = (int)(k / hpa->cl_cols) * hpa->size;
+		hpaBfs(hpa, k, a->x, a->y);
+		c = (b->y - y0) * hpa->size + (b->x - x0);
+		for (c = hpa->from[c]; c >= 0; c = hpa->from[c])
+			if (!hpaPushCell(path, x0 + c % hpa->size,
+					 y0 + c / hpa->size))
+				return (0);
+	}
+
+	return (1);
+}
+
+
+/**
+  * hpa_path - searches for a path between two cells of a hierarchical map:
+  *   first over the abstract graph, then refined cluster by cluster
+  *
+  * @hpa: pointer to the hierarchical map
+  * @start: coordinates of the starting point
+  * @target: coordinates of the target point
+  * Return: returns a queue in which each node is a point in the path from
+  *   start to target, or NULL on failure or if there is no path
+  */
+queue_t *hpa_path(hpa_t *hpa, point_t const *start, point_t const *target)
+{
+	queue_t *path = NULL;
+	size_t s, t = HPA_NONE;
+	int s_tmp = 0, t_tmp = 0, ok;
+
+	if (!hpa || !start || !target ||
+	    !hpaWalkable(hpa, start->x, start->y) ||
+	    !hpaWalkable(hpa, target->x, target->y))
+		return (NULL);
+
+	s = hpaTempNode(hpa, start, &s_tmp);
+	if (s != HPA_NONE)
+		t = hpaTempNode(hpa, target, &t_tmp);
+	path = queue_create();
+	ok = path && t != HPA_NONE && hpaSearch(hpa, s, t) &&
+		hpaRefine(hpa, path, t);
+	if (t_tmp)
+		hpaTempRemove(hpa, t);
+	if (s_tmp)
+		hpaTempRemove(hpa, s);
+	if (!ok && path)
+	{
+		while (path->front)
+			free(dequeue(path));
+		queue_delete(path);
+		path = NULL;
+	}
+
+	return (path);
+}
+
+
+/**
+  * hpa_delete - deallocates a hierarchical map, including its abstract
+  *   graph; the map itself is left untouched
+  *
+  * @hpa: pointer to the hierarchical map to delete
+  */
+void hpa_delete(hpa_t *hpa)
+{
+	size_t k;
+
+	if (!hpa)
+		return;
+
+	for (k = 0; hpa->clusters && k < hpa->cl_cols * hpa->cl_rows; k++)
+	{
+		free(hpa->clusters[k].nodes);
+		free(hpa->clusters[k].border[HPA_EAST]);
+		free(hpa->clusters[k].border[HPA_SOUTH]);
+	}
+	free(hpa->clusters);
+	if (hpa->abstract)
+		graph_delete(hpa->abstract);
+	free(hpa->nodes);
+	free(hpa->free);
+	free(hpa->retired);
+	free(hpa->dist);
+	free(hpa->from);
+	free(hpa->bfs);
+	free(hpa->g);
+	free(hpa->via);
+	free(hpa->stamp);
+	index_heap_delete(hpa->open);
+	free(hpa);
+}
+
+
+/**
+  * hpa_create - splits a grid map into square clusters and precomputes the
+  *   abstract graph used by hierarchical pathfinding: a vertex for each
+  *   transition cell between clusters, and edges weighted by the distance
+  *   between transition cells of the same cluster
+  *
+  * @map: pointer to a two-dimensional array (0 represents a walkable cell,
+  *   1 represents a blocked cell); it must stay valid, and is only written
+  *   to by hpa_set_cell()
+  * @rows: count of rows in map
+  * @cols: count of columns in map
+  * @cluster_size: width and height of the clusters, in cells
+  * Return: pointer to the hierarchical map, or NULL on failure
+  */
+hpa_t *hpa_create(char **map, int rows, int cols, int cluster_size)
+{
+	hpa_t *hpa = NULL;
+	size_t k, n;
+	int ok = 1;
+
+	if (!map || rows <= 0 || cols <= 0 || cluster_size <= 0)
+		return (NULL);
+
+	hpa = calloc(1, sizeof(hpa_t));
+	if (!hpa)
+		return (NULL);
+	hpa->map = map;
+	hpa->rows = rows;
+	hpa->cols = cols;
+	hpa->size = cluster_size;
+	hpa->cl_cols = (cols + cluster_size - 1) / cluster_size;
+	hpa->cl_rows = (rows + cluster_size - 1) / cluster_size;
+	n = hpa->cl_cols * hpa->cl_rows;
+	hpa->clusters = calloc(n, sizeof(hpa_cluster_t));
+	hpa->abstract = graph_create();
+	hpa->dist = malloc(sizeof(int) * cluster_size * cluster_size);
+	hpa->from = malloc(sizeof(int) * cluster_size * cluster_size);
+	hpa->bfs = malloc(sizeof(int) * cluster_size * cluster_size);
+	if (!hpa->clusters || !hpa->abstract || !hpa->dist || !hpa->from ||
+	    !hpa->bfs)
+		ok = 0;
+	for (k = 0; ok && k < n; k++)
+		ok = hpaBorderBuild(hpa, k, HPA_EAST) &&
+			hpaBorderBuild(hpa, k, HPA_SOUTH);
+	for (k = 0; ok && k < n; k++)
+		ok = hpaClusterLink(hpa, k);
+	if (!ok)
+	{
+		hpa_delete(hpa);
+		return (NULL);
+	}
+
+	return (hpa);
+}
+
+
+/**
+  * hpa_set_cell - blocks or clears a map cell, and updates only the parts of
+  *   the abstract graph it affects: the intra-cluster edges of its cluster,
+  *   and if it lies on a cluster border, the transitions across that border
+  *   and the intra-cluster edges of the neighbouring cluster
+  *
+  * @hpa: pointer to the hierarchical map
+  * @x: X coordinate of the cell
+  * @y: Y coordinate of the cell
+  * @blocked: 1 to block the cell, 0 to make it walkable
+  * Return: 1 on success, 0 on failure
+  */
+int hpa_set_cell(hpa_t *hpa, int x, int y, int blocked)
+{
+	size_t k, touched[5], owner[4], nb = 0, i;
+	int edge[4], s, ok = 1;
+
+	if (!hpa || x < 0 || y < 0 || x >= hpa->cols || y >= hpa->rows)
+		return (0);
+	if (hpaWalkable(hpa, x, y) == !blocked)
+		return (1);
+
+	hpa->map[y][x] = blocked ? '1' : '0';
+	s = hpa->size;
+	k = hpaCluster(hpa, x, y);
+	touched[nb++] = k;
+	edge[0] = x % s == 0 && x > 0;
+	edge[1] = (x % s == s - 1 && x + 1 < hpa->cols);
+	edge[2] = y % s == 0 && y > 0;
+	edge[3] = (y % s == s - 1 && y + 1 < hpa->rows);
+	if (edge[0])
+		touched[nb++] = k - 1;
+	if (edge[1])
+		touched[nb++] = k + 1;
+	if (edge[2])
+		touched[nb++] = k - hpa->cl_cols;
+	if (edge[3])
+		touched[nb++] = k + hpa->cl_cols;
+	/* clusters whose east or south border is the cell's west, east, */
+	/* north and south border respectively */
+	owner[0] = k - 1;
+	owner[1] = k;
+	owner[2] = k - hpa->cl_cols;
+	owner[3] = k;
+	for (i = 0; i < 4; i++)
+		if (edge[i])
+			hpaBorderClear(hpa, owner[i],
+				       i < 2 ? HPA_EAST : HPA_SOUTH);
+	for (i = 0; ok && i < 4; i++)
+		if (edge[i])
+			ok = hpaBorderBuild(hpa, owner[i],
+					    i < 2 ? HPA_EAST : HPA_SOUTH);
+	for (i = 0; ok && i < nb; i++)
+		ok = hpaClusterLink(hpa, touched[i]);
+	while (hpa->nb_retired)
+		hpa->free[hpa->nb_free++] = hpa->retired[--hpa->nb_retired];
+
+	return (ok);
+}
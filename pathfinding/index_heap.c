@@ -0,0 +1,184 @@
+#include "pathfinding.h"
+/* malloc calloc free */
+#include <stdlib.h>
+
+
+/**
+  * indexHeapLess - compares the keys of two vertex indices, primary key
+  *   first and secondary key as tiebreaker
+  *
+  * @heap: pointer to the heap holding the keys
+  * @a: first vertex index
+  * @b: second vertex index
+  * Return: 1 if @a orders strictly before @b, 0 otherwise
+  */
+static int indexHeapLess(const index_heap_t *heap, size_t a, size_t b)
+{
+	if (heap->k1[a] != heap->k1[b])
+		return (heap->k1[a] < heap->k1[b]);
+	return (heap->k2[a] < heap->k2[b]);
+}
+
+
+/**
+  * indexHeapSift - restores the heap property around one position, moving
+  *   its vertex index up towards the root or down towards the leaves
+  *
+  * @heap: pointer to the heap
+  * @i: position in @heap->heap to sift
+  */
+static void indexHeapSift(index_heap_t *heap, size_t i)
+{
+	size_t v = heap->heap[i], parent, child;
+
+	while (i > 0)
+	{
+		parent = (i - 1) / 2;
+		if (!indexHeapLess(heap, v, heap->heap[parent]))
+			break;
+		heap->heap[i] = heap->heap[parent];
+		heap->pos[heap->heap[i]] = i;
+		i = parent;
+	}
+	while ((child = 2 * i + 1) < heap->size)
+	{
+		if (child + 1 < heap->size &&
+		    indexHeapLess(heap, heap->heap[child + 1],
+				  heap->heap[child]))
+			child++;
+		if (!indexHeapLess(heap, heap->heap[child], v))
+			break;
+		heap->heap[i] = heap->heap[child];
+		heap->pos[heap->heap[i]] = i;
+		i = child;
+	}
+	heap->heap[i] = v;
+	heap->pos[v] = i;
+}
+
+
+/**
+  * index_heap_create - allocates an indexed min-heap able to hold every
+  *   vertex index in [0, capacity)
+  *
+  * @capacity: amount of distinct vertex indices, usually graph->nb_vertices
+  * Return: pointer to the new heap, or NULL on failure
+  */
+index_heap_t *index_heap_create(size_t capacity)
+{
+	index_heap_t *heap = NULL;
+	size_t i;
+
+	heap = calloc(1, sizeof(index_heap_t));
+	if (!heap)
+		return (NULL);
+
+	heap->heap = malloc(sizeof(size_t) * (capacity ? capacity : 1));
+	heap->pos = malloc(sizeof(size_t) * (capacity ? capacity : 1));
+	heap->k1 = malloc(sizeof(size_t) * (capacity ? capacity : 1));
+	heap->k2 = malloc(sizeof(size_t) * (capacity ? capacity : 1));
+	if (!heap->heap || !heap->pos || !heap->k1 || !heap->k2)
+	{
+		index_heap_delete(heap);
+		return (NULL);
+	}
+	for (i = 0; i < capacity; i++)
+		heap->pos[i] = INDEX_HEAP_NONE;
+	heap->capacity = capacity;
+
+	return (heap);
+}
+
+
+/**
+  * index_heap_push - inserts a vertex index in the heap, or updates its keys
+  *   if it is already queued
+  *
+  * @heap: pointer to the heap
+  * @i: vertex index
+  * @k1: primary key
+  * @k2: secondary key, compared only when primary keys are equal
+  * Return: 1 on success, 0 on failure
+  */
+int index_heap_push(index_heap_t *heap, size_t i, size_t k1, size_t k2)
+{
+	if (!heap || i >= heap->capacity)
+		return (0);
+
+	heap->k1[i] = k1;
+	heap->k2[i] = k2;
+	if (heap->pos[i] == INDEX_HEAP_NONE)
+	{
+		heap->heap[heap->size] = i;
+		heap->pos[i] = heap->size++;
+	}
+	indexHeapSift(heap, heap->pos[i]);
+
+	return (1);
+}
+
+
+/**
+  * index_heap_remove - removes a vertex index from the heap, wherever it
+  *   currently is
+  *
+  * @heap: pointer to the heap
+  * @i: vertex index
+  * Return: 1 if @i was queued and has been removed, 0 otherwise
+  */
+int index_heap_remove(index_heap_t *heap, size_t i)
+{
+	size_t p;
+
+	if (!heap || i >= heap->capacity || heap->pos[i] == INDEX_HEAP_NONE)
+		return (0);
+
+	p = heap->pos[i];
+	heap->pos[i] = INDEX_HEAP_NONE;
+	if (p != --heap->size)
+	{
+		heap->heap[p] = heap->heap[heap->size];
+		heap->pos[heap->heap[p]] = p;
+		indexHeapSift(heap, p);
+	}
+
+	return (1);
+}
+
+
+/**
+  * index_heap_pop - removes the vertex index with the smallest keys
+  *
+  * @heap: pointer to the heap
+  * Return: popped vertex index, or INDEX_HEAP_NONE if the heap is empty
+  */
+size_t index_heap_pop(index_heap_t *heap)
+{
+	size_t top;
+
+	if (!heap || !heap->size)
+		return (INDEX_HEAP_NONE);
+
+	top = heap->heap[0];
+	index_heap_remove(heap, top);
+
+	return (top);
+}
+
+
+/**
+  * index_heap_delete - deallocates an indexed min-heap
+  *
+  * @heap: pointer to the heap to delete
+  */
+void index_heap_delete(index_heap_t *heap)
+{
+	if (!heap)
+		return;
+
+	free(heap->heap);
+	free(heap->pos);
+	free(heap->k1);
+	free(heap->k2);
+	free(heap);
+}
@@ -0,0 +1,348 @@
+#include "pathfinding.h"
+/* malloc calloc realloc free */
+#include <stdlib.h>
+/* memcpy memcmp */
+#include <string.h>
+
+
+/**
+  * struct yen_path_s - path as a sequence of snapshot edge indices, used
+  *   for both accepted paths and candidates
+  *
+  * @cost: sum of the weights of the edges
+  * @len: amount of edges
+  * @hash: hash of the edge sequence, speeds up duplicate detection
+  * @edges: edge indices in the graph_csr_t snapshot, from start to target
+  */
+typedef struct yen_path_s
+{
+	size_t cost;
+	size_t len;
+	size_t hash;
+	size_t *edges;
+} yen_path_t;
+
+/**
+  * struct yen_heap_s - binary min-heap of candidate paths, ordered by cost
+  *   then by amount of edges
+  *
+  * @paths: candidate paths, in heap order
+  * @size: amount of candidates
+  * @capacity: allocated length of @paths
+  */
+typedef struct yen_heap_s
+{
+	yen_path_t **paths;
+	size_t size;
+	size_t capacity;
+} yen_heap_t;
+
+
+/**
+  * yenLess - orders two candidate paths by cost, then by amount of edges
+  *
+  * @a: first path
+  * @b: second path
+  * Return: 1 if @a orders strictly before @b, 0 otherwise
+  */
+static int yenLess(const yen_path_t *a, const yen_path_t *b)
+{
+	if (a->cost != b->cost)
+		return (a->cost < b->cost);
+	return (a->len < b->len);
+}
+
+
+/**
+  * yenHeapPush - adds a candidate path to the heap unless an identical path
+  *   is already queued; the heap takes ownership of @path either way
+  *
+  * @heap: pointer to the candidate heap
+  * @path: candidate path
+  * Return: 1 on success, 0 on failure
+  */
+static int yenHeapPush(yen_heap_t *heap, yen_path_t *path)
+{
+	yen_path_t **grown = NULL;
+	size_t i, parent;
+
+	for (i = 0; i < heap->size; i++)
+		if (heap->paths[i]->hash == path->hash &&
+		    heap->paths[i]->len == path->len &&
+		    !memcmp(heap->paths[i]->edges, path->edges,
+			    sizeof(size_t) * path->len))
+		{
+			free(path->edges);
+			free(path);
+			return (1);
+		}
+	if (heap->size == heap->capacity)
+	{
+		grown = realloc(heap->paths, sizeof(yen_path_t *) *
+				(heap->capacity ? heap->capacity * 2 : 16));
+		if (!grown)
+		{
+			free(path->edges);
+			free(path);
+			return (0);
+		}
+		heap->paths = grown;
+		heap->capacity = heap->capacity ? heap->capacity * 2 : 16;
+	}
+	for (i = heap->size++; i > 0; i = parent)
+	{
+		parent = (i - 1) / 2;
+		if (!yenLess(path, heap->paths[parent]))
+			break;
+		heap->paths[i] = heap->paths[parent];
+	}
+	heap->paths[i] = path;
+
+	return (1);
+}
+
+
+/**
+  * yenHeapPop - removes the cheapest candidate path from the heap
+  *
+  * @heap: pointer to the candidate heap
+  * Return: cheapest candidate, or NULL if the heap is empty
+  */
+static yen_path_t *yenHeapPop(yen_heap_t *heap)
+{
+	yen_path_t *top = NULL, *last = NULL;
+	size_t i = 0, child;
+
+	if (!heap->size)
+		return (NULL);
+
+	top = heap->paths[0];
+	last = heap->paths[--heap->size];
+	while ((child = 2 * i + 1) < heap->size)
+	{
+		if (child + 1 < heap->size &&
+		    yenLess(heap->paths[child + 1], heap->paths[child]))
+			child++;
+		if (!yenLess(heap->paths[child], last))
+			break;
+		heap->paths[i] = heap->paths[child];
+		i = child;
+	}
+	heap->paths[i] = last;
+
+	return (top);
+}
+
+
+/**
+  * yenSpurPath - joins the first @root_len edges of a path with the result
+  *   of the last dijkstra_csr() search into a new candidate path
+  *
+  * @csr: pointer to the snapshot, holding the spur search results
+  * @prev: path whose first @root_len edges form the root path
+  * @root_len: amount of edges in the root path
+  * @target: index of the target vertex
+  * @cost: total cost of the joined path
+  * Return: pointer to the new candidate, or NULL on failure
+  */
+static yen_path_t *yenSpurPath(graph_csr_t *csr, const yen_path_t *prev,
+			       size_t root_len, size_t target, size_t cost)
+{
+	yen_path_t *path = NULL;
+	size_t v, n = 0, i;
+
+	for (v = target; csr->via[v] != CSR_NONE; v = csr->src[csr->via[v]])
+		n++;
+	path = malloc(sizeof(yen_path_t));
+	if (!path)
+		return (NULL);
+	path->edges = malloc(sizeof(size_t) * (root_len + n + 1));
+	if (!path->edges)
+	{
+		free(path);
+		return (NULL);
+	}
+	if (root_len)
+		memcpy(path->edges, prev->edges, sizeof(size_t) * root_len);
+	path->len = root_len + n;
+	for (v = target; csr->via[v] != CSR_NONE; v = csr->src[csr->via[v]])
+		path->edges[root_len + --n] = csr->via[v];
+	path->cost = cost;
+	for (i = 0, path->hash = 0; i < path->len; i++)
+		path->hash = path->hash * 31 + path->edges[i];
+
+	return (path);
+}
+
+
+/**
+  * yenDeviations - pushes every spur path deviating from the last accepted
+  *   path onto the candidate heap, masking the edges already taken by
+  *   accepted paths sharing the same root, and the root path's vertices
+  *
+  * @csr: pointer to the snapshot
+  * @a: accepted paths, the last one being the one to deviate from
+  * @nb_a: amount of accepted paths
+  * @b: candidate heap
+  * @target: index of the target vertex
+  * Return: 1 on success, 0 on failure
+  */
+static int yenDeviations(graph_csr_t *csr, yen_path_t **a, size_t nb_a,
+			 yen_heap_t *b, size_t target)
+{
+	yen_path_t *prev = a[nb_a - 1], *spur = NULL;
+	size_t i, j, spur_v, root_cost = 0, cost;
+	int ok = 1;
+
+	for (i = 0; ok && i < prev->len; i++)
+	{
+		spur_v = csr->src[prev->edges[i]];
+		for (j = 0; j < nb_a; j++)
+			if (a[j]->len > i &&
+			    !memcmp(a[j]->edges, prev->edges,
+				    sizeof(size_t) * i))
+				csr->edge_mask[a[j]->edges[i]] = 1;
+		cost = dijkstra_csr(csr, spur_v, target);
+		if (cost != CSR_INF)
+		{
+			spur = yenSpurPath(csr, prev, i, target,
+					   root_cost + cost);
+			ok = spur && yenHeapPush(b, spur);
+		}
+		for (j = 0; j < nb_a; j++)
+			if (a[j]->len > i)
+				csr->edge_mask[a[j]->edges[i]] = 0;
+		csr->vertex_mask[spur_v] = 1;
+		root_cost += csr->weight[prev->edges[i]];
+	}
+	for (i = 0; i < prev->len; i++)
+		csr->vertex_mask[csr->src[prev->edges[i]]] = 0;
+
+	return (ok);
+}
+
+
+/**
+  * yenResult - converts accepted edge paths into vertex index paths
+  *
+  * @csr: pointer to the snapshot
+  * @a: accepted paths
+  * @nb_a: amount of accepted paths
+  * @start: index of the starting vertex
+  * Return: pointer to the result, or NULL on failure
+  */
+static k_paths_t *yenResult(graph_csr_t *csr, yen_path_t **a, size_t nb_a,
+			    size_t start)
+{
+	k_paths_t *result = NULL;
+	size_t i, j;
+
+	result = calloc(1, sizeof(k_paths_t));
+	if (!result)
+		return (NULL);
+	result->paths = calloc(nb_a ? nb_a : 1, sizeof(k_path_t));
+	if (!result->paths)
+	{
+		free(result);
+		return (NULL);
+	}
+	for (i = 0; i < nb_a; i++, result->nb_paths++)
+	{
+		result->paths[i].vertices = malloc(sizeof(size_t) *
+						   (a[i]->len + 1));
+		if (!result->paths[i].vertices)
+		{
+			k_paths_delete(result);
+			return (NULL);
+		}
+		result->paths[i].vertices[0] = start;
+		for (j = 0; j < a[i]->len; j++)
+			result->paths[i].vertices[j + 1] =
+				csr->dest[a[i]->edges[j]];
+		result->paths[i].nb_vertices = a[i]->len + 1;
+		result->paths[i].cost = a[i]->cost;
+	}
+
+	return (result);
+}
+
+
+/**
+  * k_shortest_paths - finds up to @k loopless paths from a starting vertex
+  *   to a target vertex, in increasing order of cost, using Yen's algorithm
+  *   over a masked Dijkstra on a compressed snapshot of the graph
+  *
+  * @graph: pointer to the graph to traverse
+  * @start: pointer to starting vertex
+  * @target: pointer to target vertex
+  * @k: maximum amount of paths to find
+  * Return: paths found, as arrays of vertex indices (vertex_t->index), or
+  *   NULL on failure; the result holds no path if @target is unreachable
+  */
+k_paths_t *k_shortest_paths(graph_t *graph, vertex_t const *start,
+			    vertex_t const *target, size_t k)
+{
+	graph_csr_t *csr = NULL;
+	yen_heap_t b = {NULL, 0, 0};
+	yen_path_t **a = NULL, first = {0, 0, 0, NULL};
+	k_paths_t *result = NULL;
+	size_t nb_a = 0, cost;
+
+	if (!start || !target || !k)
+		return (NULL);
+	csr = graph_csr_create(graph);
+	a = calloc(k, sizeof(yen_path_t *));
+	if (!csr || !a || start->index >= csr->nb_vertices ||
+	    target->index >= csr->nb_vertices)
+		goto out;
+
+	cost = dijkstra_csr(csr, start->index, target->index);
+	if (cost != CSR_INF)
+		a[nb_a++] = yenSpurPath(csr, &first, 0, target->index, cost);
+	if (nb_a && !a[0])
+		goto out;
+	while (nb_a && nb_a < k)
+	{
+		if (!yenDeviations(csr, a, nb_a, &b, target->index))
+			goto out;
+		a[nb_a] = yenHeapPop(&b);
+		if (!a[nb_a])
+			break;
+		nb_a++;
+	}
+	result = yenResult(csr, a, nb_a, start->index);
+out:
+	for (cost = 0; a && cost < nb_a && a[cost]; cost++)
+	{
+		free(a[cost]->edges);
+		free(a[cost]);
+	}
+	for (cost = 0; cost < b.size; cost++)
+	{
+		free(b.paths[cost]->edges);
+		free(b.paths[cost]);
+	}
+	free(b.paths);
+	free(a);
+	graph_csr_delete(csr);
+	return (result);
+}
+
+
+/**
+  * k_paths_delete - deallocates the result of k_shortest_paths()
+  *
+  * @paths: pointer to the result to delete
+  */
+void k_paths_delete(k_paths_t *paths)
+{
+	size_t i;
+
+	if (!paths)
+		return;
+
+	for (i = 0; i < paths->nb_paths; i++)
+		free(paths->paths[i].vertices);
+	free(paths->paths);
+	free(paths);
+}
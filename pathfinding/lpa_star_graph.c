@@ -0,0 +1,354 @@
+#include "pathfinding.h"
+/* malloc calloc free */
+#include <stdlib.h>
+/* strcmp strdup */
+#include <string.h>
+
+#define LPA_INF ((size_t)-1)
+
+
+/* planners notified by update_edge_weight(); not thread-safe */
+static lpa_star_t *planners;
+
+
+/**
+  * lpaAdd - adds an edge weight to a path cost, saturating at LPA_INF so
+  *   that unreachable vertices stay unreachable
+  *
+  * @cost: path cost, or LPA_INF
+  * @weight: edge weight
+  * Return: sum of @cost and @weight, or LPA_INF on overflow
+  */
+static size_t lpaAdd(size_t cost, int weight)
+{
+	if (cost == LPA_INF || weight < 0 || cost > LPA_INF - 1 - weight)
+		return (LPA_INF);
+	return (cost + weight);
+}
+
+
+/**
+  * lpaUpdateVertex - recomputes the lookahead cost of a vertex from its
+  *   predecessors, and (re)queues it if it is locally inconsistent
+  *
+  * @planner: pointer to the route's search state
+  * @u: index of the vertex to update
+  */
+static void lpaUpdateVertex(lpa_star_t *planner, size_t u)
+{
+	size_t i, cost, k2;
+
+	if (u != planner->start)
+	{
+		planner->rhs[u] = LPA_INF;
+		for (i = planner->pred_off[u]; i < planner->pred_off[u + 1];
+		     i++)
+		{
+			cost = lpaAdd(planner->g[planner->pred_src[i]],
+				      planner->pred_edge[i]->weight);
+			if (cost < planner->rhs[u])
+				planner->rhs[u] = cost;
+		}
+	}
+
+	if (planner->g[u] == planner->rhs[u])
+	{
+		index_heap_remove(planner->open, u);
+		return;
+	}
+	k2 = planner->g[u] < planner->rhs[u] ? planner->g[u] : planner->rhs[u];
+	index_heap_push(planner->open, u,
+			k2 > LPA_INF - planner->h[u] ? LPA_INF :
+			k2 + planner->h[u], k2);
+}
+
+
+/**
+  * lpaComputeShortestPath - expands locally inconsistent vertices until the
+  *   target's cost is settled; on the first query this is a plain A* search,
+  *   on later ones only vertices affected by updated edges are expanded
+  *
+  * @planner: pointer to the route's search state
+  */
+static void lpaComputeShortestPath(lpa_star_t *planner)
+{
+	index_heap_t *open = planner->open;
+	size_t t = planner->target, u, tk1, tk2, top;
+	edge_t *edge = NULL;
+
+	while (open->size)
+	{
+		tk2 = planner->g[t] < planner->rhs[t] ? planner->g[t] :
+			planner->rhs[t];
+		tk1 = tk2 > LPA_INF - planner->h[t] ? LPA_INF :
+			tk2 + planner->h[t];
+		top = open->heap[0];
+		if ((open->k1[top] > tk1 ||
+		     (open->k1[top] == tk1 && open->k2[top] >= tk2)) &&
+		    planner->rhs[t] == planner->g[t])
+			break;
+
+		u = index_heap_pop(open);
+		if (planner->g[u] > planner->rhs[u])
+			planner->g[u] = planner->rhs[u];
+		else
+		{
+			planner->g[u] = LPA_INF;
+			lpaUpdateVertex(planner, u);
+		}
+		for (edge = planner->vertices[u]->edges; edge;
+		     edge = edge->next)
+			lpaUpdateVertex(planner, edge->dest->index);
+	}
+}
+
+
+/**
+  * lpaBuildPredecessors - indexes the graph's vertices and builds the
+  *   reverse adjacency arrays needed to compute lookahead costs
+  *
+  * @planner: pointer to a planner with @graph and @nb_vertices set
+  * Return: 1 on success, 0 on failure or if vertex indices are inconsistent
+  */
+static int lpaBuildPredecessors(lpa_star_t *planner)
+{
+	vertex_t *v = NULL;
+	edge_t *e = NULL;
+	size_t i, n = planner->nb_vertices, *fill = NULL;
+
+	for (v = planner->graph->vertices; v; v = v->next)
+	{
+		if (v->index >= n || planner->vertices[v->index])
+			return (0);
+		planner->vertices[v->index] = v;
+		for (e = v->edges; e; e = e->next)
+			planner->pred_off[e->dest->index + 1]++;
+	}
+	for (i = 0; i < n; i++)
+		planner->pred_off[i + 1] += planner->pred_off[i];
+
+	planner->pred_src = malloc(sizeof(size_t) * (planner->pred_off[n] + 1));
+	planner->pred_edge = malloc(sizeof(edge_t *) *
+				    (planner->pred_off[n] + 1));
+	fill = malloc(sizeof(size_t) * n);
+	if (!planner->pred_src || !planner->pred_edge || !fill)
+	{
+		free(fill);
+		return (0);
+	}
+	memcpy(fill, planner->pred_off, sizeof(size_t) * n);
+	for (v = planner->graph->vertices; v; v = v->next)
+		for (e = v->edges; e; e = e->next)
+		{
+			planner->pred_src[fill[e->dest->index]] = v->index;
+			planner->pred_edge[fill[e->dest->index]++] = e;
+		}
+	free(fill);
+
+	return (1);
+}
+
+
+/**
+  * lpa_star_create - sets up an incremental Lifelong Planning A* planner for
+  *   one route; the planner is notified of every update_edge_weight() on
+  *   its graph until it is deleted. Edges and vertices must not be added to
+  *   the graph while the planner exists.
+  *
+  * @graph: pointer to the graph to traverse
+  * @start: pointer to starting vertex
+  * @target: pointer to target vertex
+  * Return: pointer to the new planner, or NULL on failure
+  */
+lpa_star_t *lpa_star_create(graph_t *graph, vertex_t const *start,
+			    vertex_t const *target)
+{
+	lpa_star_t *planner = NULL;
+	size_t i, n;
+
+	if (!graph || !graph->nb_vertices || !graph->vertices ||
+	    !start || !target)
+		return (NULL);
+
+	n = graph->nb_vertices;
+	planner = calloc(1, sizeof(lpa_star_t));
+	if (!planner)
+		return (NULL);
+	planner->graph = graph;
+	planner->nb_vertices = n;
+	planner->vertices = calloc(n, sizeof(vertex_t *));
+	planner->g = malloc(sizeof(size_t) * n);
+	planner->rhs = malloc(sizeof(size_t) * n);
+	planner->h = malloc(sizeof(size_t) * n);
+	planner->pred_off = calloc(n + 1, sizeof(size_t));
+	planner->dirty = malloc(sizeof(size_t) * n);
+	planner->is_dirty = calloc(n, sizeof(unsigned char));
+	planner->open = index_heap_create(n);
+	if (!planner->vertices || !planner->g || !planner->rhs ||
+	    !planner->h || !planner->pred_off || !planner->dirty ||
+	    !planner->is_dirty || !planner->open ||
+	    !lpaBuildPredecessors(planner) || start->index >= n ||
+	    target->index >= n || planner->vertices[start->index] != start ||
+	    planner->vertices[target->index] != target)
+	{
+		lpa_star_delete(planner);
+		return (NULL);
+	}
+
+	planner->start = start->index;
+	planner->target = target->index;
+	for (i = 0; i < n; i++)
+	{
+		planner->g[i] = planner->rhs[i] = LPA_INF;
+		planner->h[i] = euclideanDist(planner->vertices[i], target);
+	}
+	planner->rhs[planner->start] = 0;
+	lpaUpdateVertex(planner, planner->start);
+
+	planner->next = planners;
+	planners = planner;
+
+	return (planner);
+}
+
+
+/**
+  * lpa_star_path - searches for the shortest path of a planner's route,
+  *   reusing the previous search and repairing only the part of it affected
+  *   by edge weights updated since the last query
+  *
+  * @planner: pointer to the route's search state
+  * Return: returns a queue in which each node is a `char *` corresponding to a
+  *   vertex, forming a path from start to target, or NULL on failure or if
+  *   the target is unreachable
+  */
+queue_t *lpa_star_path(lpa_star_t *planner)
+{
+	queue_t *path = NULL;
+	size_t u, i, p, best, cost, steps;
+	char *via_name = NULL;
+
+	if (!planner)
+		return (NULL);
+
+	while (planner->nb_dirty)
+	{
+		u = planner->dirty[--planner->nb_dirty];
+		planner->is_dirty[u] = 0;
+		lpaUpdateVertex(planner, u);
+	}
+	lpaComputeShortestPath(planner);
+	if (planner->g[planner->target] == LPA_INF)
+		return (NULL);
+
+	path = queue_create();
+	if (!path)
+		return (NULL);
+	for (u = planner->target, steps = 0; ; u = best, steps++)
+	{
+		via_name = strdup(planner->vertices[u]->content);
+		if (!via_name || !queue_push_front(path, via_name))
+			break;
+		via_name = NULL;
+		if (u == planner->start)
+			return (path);
+		best = LPA_INF;
+		for (i = planner->pred_off[u]; i < planner->pred_off[u + 1];
+		     i++)
+		{
+			p = planner->pred_src[i];
+			cost = lpaAdd(planner->g[p],
+				      planner->pred_edge[i]->weight);
+			if (cost == planner->g[u])
+				best = p;
+		}
+		if (best == LPA_INF || steps == planner->nb_vertices)
+			break;
+	}
+
+	free(via_name);
+	while (path->front)
+		free(dequeue(path));
+	queue_delete(path);
+	return (NULL);
+}
+
+
+/**
+  * update_edge_weight - changes the weight of the edge from one vertex to
+  *   another, and notifies every planner searching the graph; the search is
+  *   repaired on each planner's next query. Bidirectional connections are
+  *   made of two edges, which must be updated separately.
+  *
+  * @graph: pointer to the graph
+  * @src: string representing the vertex the edge starts from
+  * @dst: string representing the vertex the edge leads to
+  * @w: new weight of the edge
+  * Return: 1 on success, 0 on failure or if there is no such edge
+  */
+int update_edge_weight(graph_t *graph, char const *src, char const *dst,
+		       int w)
+{
+	vertex_t *v = NULL;
+	edge_t *e = NULL;
+	lpa_star_t *planner = NULL;
+
+	if (!graph || !src || !dst)
+		return (0);
+
+	for (v = graph->vertices; v && strcmp(v->content, src); v = v->next)
+		;
+	if (!v)
+		return (0);
+	for (e = v->edges; e && strcmp(e->dest->content, dst); e = e->next)
+		;
+	if (!e)
+		return (0);
+	if (e->weight == w)
+		return (1);
+
+	e->weight = w;
+	for (planner = planners; planner; planner = planner->next)
+	{
+		if (planner->graph != graph ||
+		    e->dest->index >= planner->nb_vertices ||
+		    planner->is_dirty[e->dest->index])
+			continue;
+		planner->is_dirty[e->dest->index] = 1;
+		planner->dirty[planner->nb_dirty++] = e->dest->index;
+	}
+
+	return (1);
+}
+
+
+/**
+  * lpa_star_delete - unregisters and deallocates a planner; the graph itself
+  *   is left untouched
+  *
+  * @planner: pointer to the planner to delete
+  */
+void lpa_star_delete(lpa_star_t *planner)
+{
+	lpa_star_t **link = &planners;
+
+	if (!planner)
+		return;
+
+	while (*link && *link != planner)
+		link = &(*link)->next;
+	if (*link)
+		*link = planner->next;
+
+	free(planner->vertices);
+	free(planner->g);
+	free(planner->rhs);
+	free(planner->h);
+	free(planner->pred_off);
+	free(planner->pred_src);
+	free(planner->pred_edge);
+	free(planner->dirty);
+	free(planner->is_dirty);
+	index_heap_delete(planner->open);
+	free(planner);
+}
@@ -20,6 +20,32 @@ typedef struct point_s
 } point_t;
 
 
+/* euclideanDist.c */
+/**
+  * enum heuristic_e - distances available to estimate the remaining cost
+  *   from a vertex to the target
+  *
+  * @HEURISTIC_ZERO: always 0, turns A* into Dijkstra's algorithm
+  * @HEURISTIC_MANHATTAN: |dx| + |dy|, for 4-connected grids
+  * @HEURISTIC_OCTILE: max + (sqrt(2) - 1) * min of |dx| and |dy|, for
+  *   8-connected grids with diagonal steps costing sqrt(2)
+  * @HEURISTIC_CHEBYSHEV: max of |dx| and |dy|, for 8-connected grids with
+  *   diagonal steps costing 1
+  * @HEURISTIC_EUCLIDEAN_SQ: dx^2 + dy^2, cheap but not admissible; only
+  *   suitable to rank vertices by distance
+  * @HEURISTIC_EUCLIDEAN: sqrt(dx^2 + dy^2), straight line distance
+  */
+typedef enum heuristic_e
+{
+	HEURISTIC_ZERO = 0,
+	HEURISTIC_MANHATTAN,
+	HEURISTIC_OCTILE,
+	HEURISTIC_CHEBYSHEV,
+	HEURISTIC_EUCLIDEAN_SQ,
+	HEURISTIC_EUCLIDEAN
+} heuristic_t;
+
+
 /* 2-dijkstra_graph.c */
 /**
   * struct dijkstra_vertex_s - used to implement a Dijkstra priority queue as
@@ -59,6 +85,292 @@ typedef struct a_star_vertex_s
 } a_star_vertex_t;
 
 
+/* index_heap.c */
+#define INDEX_HEAP_NONE ((size_t)-1)
+
+/**
+  * struct index_heap_s - binary min-heap of vertex indices, which tracks the
+  *   position of every queued index so that its keys can be updated or the
+  *   index removed in O(log n)
+  *
+  * @heap: queued vertex indices, in heap order
+  * @pos: position of each vertex index in @heap, or INDEX_HEAP_NONE
+  * @k1: primary key of each vertex index
+  * @k2: secondary key of each vertex index, breaks ties on @k1
+  * @size: amount of vertex indices currently queued
+  * @capacity: amount of distinct vertex indices the heap can hold
+  */
+typedef struct index_heap_s
+{
+	size_t *heap;
+	size_t *pos;
+	size_t *k1;
+	size_t *k2;
+	size_t size;
+	size_t capacity;
+} index_heap_t;
+
+
+/* lpa_star_graph.c */
+/**
+  * struct lpa_star_s - search state of one route, kept between queries by
+  *   the Lifelong Planning A* planner so that edge weight updates only
+  *   repair the affected part of the previous search
+  *
+  * @graph: graph being searched
+  * @vertices: vertices of @graph, by index
+  * @nb_vertices: amount of vertices in @graph when the planner was created
+  * @start: index of the starting vertex
+  * @target: index of the target vertex
+  * @g: cost of the best path found so far to each vertex
+  * @rhs: one-step lookahead cost of each vertex, based on its predecessors
+  * @h: heuristic distance from each vertex to the target
+  * @pred_off: offset of each vertex's predecessors in @pred_src/@pred_edge
+  * @pred_src: index of the source vertex of each incoming edge
+  * @pred_edge: each incoming edge, to read its current weight
+  * @open: priority queue of locally inconsistent vertices
+  * @dirty: indices of vertices with an incoming edge updated since the last
+  *   query
+  * @nb_dirty: amount of indices in @dirty
+  * @is_dirty: per vertex flag, set while its index is in @dirty
+  * @next: next planner registered for edge weight updates
+  */
+typedef struct lpa_star_s
+{
+	graph_t *graph;
+	vertex_t **vertices;
+	size_t nb_vertices;
+	size_t start;
+	size_t target;
+	size_t *g;
+	size_t *rhs;
+	size_t *h;
+	size_t *pred_off;
+	size_t *pred_src;
+	edge_t **pred_edge;
+	index_heap_t *open;
+	size_t *dirty;
+	size_t nb_dirty;
+	unsigned char *is_dirty;
+	struct lpa_star_s *next;
+} lpa_star_t;
+
+
+/* graph_csr.c */
+#define CSR_INF ((size_t)-1)
+#define CSR_NONE ((size_t)-1)
+
+/**
+  * struct graph_csr_s - compressed sparse row snapshot of a graph, with masks
+  *   to temporarily hide vertices and edges, and a search workspace reused
+  *   by every dijkstra_csr() call so that searches allocate nothing
+  *
+  * @nb_vertices: amount of vertices
+  * @nb_edges: amount of edges
+  * @vertices: vertices of the graph, by index
+  * @off: offset of each vertex's outgoing edges in the edge arrays; the
+  *   edges of vertex i are [off[i], off[i + 1])
+  * @src: source vertex index of each edge
+  * @dest: destination vertex index of each edge
+  * @weight: weight of each edge (negative weights are clamped to 0)
+  * @edge_mask: per edge flag, masked edges are skipped by searches
+  * @vertex_mask: per vertex flag, masked vertices are skipped by searches
+  * @dist: distance from the start of the last search, valid where @stamp
+  *   equals @generation
+  * @via: index of the edge leading to each vertex on the shortest path
+  *   found by the last search, or CSR_NONE for its start
+  * @stamp: generation of the last search that reached each vertex
+  * @generation: generation of the last search
+  * @open: priority queue of the search
+  */
+typedef struct graph_csr_s
+{
+	size_t nb_vertices;
+	size_t nb_edges;
+	vertex_t **vertices;
+	size_t *off;
+	size_t *src;
+	size_t *dest;
+	size_t *weight;
+	unsigned char *edge_mask;
+	unsigned char *vertex_mask;
+	size_t *dist;
+	size_t *via;
+	size_t *stamp;
+	size_t generation;
+	index_heap_t *open;
+} graph_csr_t;
+
+
+/* k_shortest_paths.c */
+/**
+  * struct k_path_s - one of the paths found by k_shortest_paths()
+  *
+  * @vertices: indices (vertex_t->index) of the vertices along the path, from
+  *   start to target
+  * @nb_vertices: amount of vertices along the path
+  * @cost: sum of the weights of the edges along the path
+  */
+typedef struct k_path_s
+{
+	size_t *vertices;
+	size_t nb_vertices;
+	size_t cost;
+} k_path_t;
+
+/**
+  * struct k_paths_s - paths found by k_shortest_paths(), cheapest first
+  *
+  * @paths: array of paths
+  * @nb_paths: amount of paths found, at most the amount requested
+  */
+typedef struct k_paths_s
+{
+	k_path_t *paths;
+	size_t nb_paths;
+} k_paths_t;
+
+
+/* spatial_index.c */
+/**
+  * struct spatial_point_s - vertex coordinates stored in a spatial index
+  *
+  * @x: X coordinate of the vertex
+  * @y: Y coordinate of the vertex
+  * @vertex: indexed vertex
+  */
+typedef struct spatial_point_s
+{
+	int x;
+	int y;
+	vertex_t *vertex;
+} spatial_point_t;
+
+/**
+  * struct spatial_index_s - k-d tree over vertex coordinates, laid out
+  *   implicitly in one array: the middle point of each range splits it,
+  *   alternately on X and Y, and the halves on either side are its subtrees
+  *
+  * @points: indexed points, in tree order
+  * @nb_points: amount of indexed points
+  */
+typedef struct spatial_index_s
+{
+	spatial_point_t *points;
+	size_t nb_points;
+} spatial_index_t;
+
+
+/* hpa_star.c */
+#define HPA_NONE ((size_t)-1)
+
+/**
+  * struct hpa_node_s - node of the abstract graph of a hierarchical map,
+  *   standing for one transition cell between two clusters
+  *
+  * @vertex: vertex of the node in the abstract graph; its coordinates are
+  *   those of the cell, and its index that of the node
+  * @cluster: index of the cluster holding the cell, or HPA_NONE if the node
+  *   is free
+  * @refs: amount of transitions using the cell
+  */
+typedef struct hpa_node_s
+{
+	vertex_t *vertex;
+	size_t cluster;
+	size_t refs;
+} hpa_node_t;
+
+/**
+  * struct hpa_transition_s - pair of adjacent walkable cells on either side
+  *   of a cluster border
+  *
+  * @a: index of the node on the west or north side
+  * @b: index of the node on the east or south side
+  */
+typedef struct hpa_transition_s
+{
+	size_t a;
+	size_t b;
+} hpa_transition_t;
+
+/**
+  * struct hpa_cluster_s - square block of cells of a hierarchical map
+  *
+  * @nodes: indices of the nodes inside the cluster
+  * @nb_nodes: amount of nodes inside the cluster
+  * @cap_nodes: allocated length of @nodes
+  * @border: transitions across the east [0] and south [1] borders
+  * @nb_border: amount of transitions across each border
+  * @cap_border: allocated length of each of @border
+  */
+typedef struct hpa_cluster_s
+{
+	size_t *nodes;
+	size_t nb_nodes;
+	size_t cap_nodes;
+	hpa_transition_t *border[2];
+	size_t nb_border[2];
+	size_t cap_border[2];
+} hpa_cluster_t;
+
+/**
+  * struct hpa_s - grid map split into clusters for hierarchical pathfinding
+  *   (HPA*), with the abstract graph linking the clusters' transition cells
+  *
+  * @map: two-dimensional array, '1' for blocked cells
+  * @rows: count of rows in map
+  * @cols: count of columns in map
+  * @size: width and height of a cluster, in cells
+  * @cl_cols: amount of clusters per row
+  * @cl_rows: amount of clusters per column
+  * @clusters: clusters, row by row
+  * @abstract: abstract graph; a vertex per node, named "x,y"
+  * @nodes: nodes of the abstract graph, by vertex index
+  * @nb_nodes: amount of nodes, in use or free
+  * @cap: allocated length of @nodes, @free and @retired
+  * @free: indices of free nodes, ready to be reused
+  * @nb_free: amount of indices in @free
+  * @retired: indices of nodes freed during an update, which may still be
+  *   the destination of edges until their cluster is relinked
+  * @nb_retired: amount of indices in @retired
+  * @dist: breadth-first search distances inside a cluster
+  * @from: breadth-first search previous cells inside a cluster
+  * @bfs: breadth-first search queue
+  * @g: abstract search cost of each node
+  * @via: abstract search previous node of each node
+  * @stamp: abstract search generation that last reached each node
+  * @generation: generation of the last abstract search
+  * @open: abstract search priority queue
+  */
+typedef struct hpa_s
+{
+	char **map;
+	int rows;
+	int cols;
+	int size;
+	size_t cl_cols;
+	size_t cl_rows;
+	hpa_cluster_t *clusters;
+	graph_t *abstract;
+	hpa_node_t *nodes;
+	size_t nb_nodes;
+	size_t cap;
+	size_t *free;
+	size_t nb_free;
+	size_t *retired;
+	size_t nb_retired;
+	int *dist;
+	int *from;
+	int *bfs;
+	size_t *g;
+	size_t *via;
+	size_t *stamp;
+	size_t generation;
+	index_heap_t *open;
+} hpa_t;
+
+
 /* 0-backtracking_array.c */
 queue_t *backtracking_array(char **map, int rows, int cols,
 			    point_t const *start, point_t const *target);
@@ -73,10 +385,56 @@ queue_t *dijkstra_graph(graph_t *graph, vertex_t const *start,
 
 /* euclideanDist.c */
 size_t euclideanDist(const vertex_t *vertex, const vertex_t *target);
+size_t heuristic_dist(heuristic_t heuristic, const vertex_t *vertex,
+		      const vertex_t *target);
+void heuristic_batch(heuristic_t heuristic, const int *xs, const int *ys,
+		     size_t n, const vertex_t *target, size_t *out);
+size_t heuristic_edges(heuristic_t heuristic, const vertex_t *vertex,
+		       const vertex_t *target, size_t *out, size_t max);
 
 /* 100-a_star_graph.c */
 queue_t *a_star_graph(graph_t *graph, vertex_t const *start,
 		      vertex_t const *target);
+queue_t *a_star_graph_heuristic(graph_t *graph, vertex_t const *start,
+				vertex_t const *target, heuristic_t heuristic);
+
+/* index_heap.c */
+index_heap_t *index_heap_create(size_t capacity);
+int index_heap_push(index_heap_t *heap, size_t i, size_t k1, size_t k2);
+int index_heap_remove(index_heap_t *heap, size_t i);
+size_t index_heap_pop(index_heap_t *heap);
+void index_heap_delete(index_heap_t *heap);
+
+/* lpa_star_graph.c */
+lpa_star_t *lpa_star_create(graph_t *graph, vertex_t const *start,
+			    vertex_t const *target);
+queue_t *lpa_star_path(lpa_star_t *planner);
+int update_edge_weight(graph_t *graph, char const *src, char const *dst,
+		       int w);
+void lpa_star_delete(lpa_star_t *planner);
+
+/* graph_csr.c */
+graph_csr_t *graph_csr_create(graph_t *graph);
+size_t dijkstra_csr(graph_csr_t *csr, size_t start, size_t target);
+void graph_csr_delete(graph_csr_t *csr);
+
+/* k_shortest_paths.c */
+k_paths_t *k_shortest_paths(graph_t *graph, vertex_t const *start,
+			    vertex_t const *target, size_t k);
+void k_paths_delete(k_paths_t *paths);
+
+/* spatial_index.c */
+spatial_index_t *spatial_index_create(graph_t *graph);
+vertex_t *graph_nearest_vertex(spatial_index_t const *index, int x, int y);
+size_t graph_vertices_in_radius(spatial_index_t const *index, int x, int y,
+				size_t radius, vertex_t **out, size_t max);
+void spatial_index_delete(spatial_index_t *index);
+
+/* hpa_star.c */
+hpa_t *hpa_create(char **map, int rows, int cols, int cluster_size);
+queue_t *hpa_path(hpa_t *hpa, point_t const *start, point_t const *target);
+int hpa_set_cell(hpa_t *hpa, int x, int y, int blocked);
+void hpa_delete(hpa_t *hpa);
 
 
 #endif /* PATHFINDING_H */
\ No newline at end of file
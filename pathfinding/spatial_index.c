@@ -0,0 +1,313 @@
+#include "pathfinding.h"
+/* malloc calloc free */
+#include <stdlib.h>
+
+#define SPATIAL_SWAP(a, b, tmp) ((tmp) = (a), (a) = (b), (b) = (tmp))
+
+
+/**
+  * spatialSquare - square of a difference of two coordinates, computed
+  *   unsigned so that it cannot overflow
+  *
+  * @delta: difference of two int coordinates
+  * Return: @delta squared
+  */
+static size_t spatialSquare(long delta)
+{
+	size_t d = delta < 0 ? -(size_t)delta : (size_t)delta;
+
+	return (d * d);
+}
+
+
+/**
+  * spatialDist - squared distance between a point and a tree point,
+  *   saturating instead of overflowing
+  *
+  * @p: tree point
+  * @x: X coordinate of the query point
+  * @y: Y coordinate of the query point
+  * Return: squared Euclidean distance
+  */
+static size_t spatialDist(const spatial_point_t *p, int x, int y)
+{
+	size_t d2x = spatialSquare((long)p->x - x);
+	size_t d2y = spatialSquare((long)p->y - y);
+
+	return (d2x > (size_t)-1 - d2y ? (size_t)-1 : d2x + d2y);
+}
+
+
+/**
+  * spatialSelect - partially sorts a range of tree points so that the median
+  *   along one axis lands in the middle, smaller coordinates before it and
+  *   larger ones after it (quickselect with a three-way partition, so that
+  *   rows or columns of equal coordinates do not degrade it)
+  *
+  * @pts: tree points
+  * @lo: first index of the range
+  * @hi: one past the last index of the range
+  * @axis: 0 to split on X coordinates, 1 to split on Y coordinates
+  */
+static void spatialSelect(spatial_point_t *pts, size_t lo, size_t hi,
+			  int axis)
+{
+	size_t mid = lo + (hi - lo) / 2, lt, i, gt;
+	spatial_point_t tmp;
+	int pivot, c;
+
+	while (hi - lo > 1)
+	{
+		pivot = axis ? pts[mid].y : pts[mid].x;
+		for (lt = i = lo, gt = hi; i < gt; )
+		{
+			c = axis ? pts[i].y : pts[i].x;
+			if (c < pivot)
+			{
+				SPATIAL_SWAP(pts[i], pts[lt], tmp);
+				lt++;
+				i++;
+			}
+			else if (c > pivot)
+			{
+				gt--;
+				SPATIAL_SWAP(pts[i], pts[gt], tmp);
+			}
+			else
+				i++;
+		}
+		if (mid < lt)
+			hi = lt;
+		else if (mid >= gt)
+			lo = gt;
+		else
+			return;
+	}
+}
+
+
+/**
+  * spatialBuild - lays out a k-d tree implicitly in an array: the median of
+  *   each range is its node, the halves on either side its subtrees, with
+  *   the splitting axis alternating between X and Y at each level
+  *
+  * @pts: tree points
+  * @lo: first index of the range
+  * @hi: one past the last index of the range
+  * @axis: splitting axis for this level
+  */
+static void spatialBuild(spatial_point_t *pts, size_t lo, size_t hi, int axis)
+{
+	size_t mid;
+
+	if (hi - lo < 2)
+		return;
+
+	mid = lo + (hi - lo) / 2;
+	spatialSelect(pts, lo, hi, axis);
+	spatialBuild(pts, lo, mid, !axis);
+	spatialBuild(pts, mid + 1, hi, !axis);
+}
+
+
+/**
+  * spatial_index_create - builds a k-d tree over the coordinates of a
+  *   graph's vertices, to snap arbitrary points to vertices in O(log V);
+  *   vertices added to the graph later are not indexed
+  *
+  * @graph: pointer to the graph
+  * Return: pointer to the new index, or NULL on failure
+  */
+spatial_index_t *spatial_index_create(graph_t *graph)
+{
+	spatial_index_t *index = NULL;
+	vertex_t *v = NULL;
+	size_t i;
+
+	if (!graph || !graph->nb_vertices || !graph->vertices)
+		return (NULL);
+
+	index = calloc(1, sizeof(spatial_index_t));
+	if (!index)
+		return (NULL);
+	index->points = malloc(sizeof(spatial_point_t) * graph->nb_vertices);
+	if (!index->points)
+	{
+		free(index);
+		return (NULL);
+	}
+	for (i = 0, v = graph->vertices; v && i < graph->nb_vertices;
+	     i++, v = v->next)
+	{
+		index->points[i].x = v->x;
+		index->points[i].y = v->y;
+		index->points[i].vertex = v;
+	}
+	index->nb_points = i;
+	spatialBuild(index->points, 0, index->nb_points, 0);
+
+	return (index);
+}
+
+
+/**
+  * spatialNearest - descends the k-d tree towards a query point, visiting
+  *   the far side of a split only if it may hold a closer point
+  *
+  * @pts: tree points
+  * @lo: first index of the subtree's range
+  * @hi: one past the last index of the subtree's range
+  * @axis: splitting axis of the subtree's root
+  * @q: query point
+  * @best: closest point found so far, updated in place
+  * @best_d: squared distance to @best, updated in place
+  */
+static void spatialNearest(const spatial_point_t *pts, size_t lo, size_t hi,
+			   int axis, const point_t *q,
+			   const spatial_point_t **best, size_t *best_d)
+{
+	size_t mid, d;
+	long delta;
+
+	if (lo >= hi)
+		return;
+
+	mid = lo + (hi - lo) / 2;
+	d = spatialDist(pts + mid, q->x, q->y);
+	if (d < *best_d)
+	{
+		*best_d = d;
+		*best = pts + mid;
+	}
+	delta = axis ? (long)q->y - pts[mid].y : (long)q->x - pts[mid].x;
+	if (delta < 0)
+	{
+		spatialNearest(pts, lo, mid, !axis, q, best, best_d);
+		if (spatialSquare(delta) < *best_d)
+			spatialNearest(pts, mid + 1, hi, !axis, q, best,
+				       best_d);
+	}
+	else
+	{
+		spatialNearest(pts, mid + 1, hi, !axis, q, best, best_d);
+		if (spatialSquare(delta) < *best_d)
+			spatialNearest(pts, lo, mid, !axis, q, best, best_d);
+	}
+}
+
+
+/**
+  * graph_nearest_vertex - finds the indexed vertex closest to a point
+  *
+  * @index: pointer to the spatial index
+  * @x: X coordinate of the point
+  * @y: Y coordinate of the point
+  * Return: pointer to the closest vertex (by Euclidean distance, ties broken
+  *   arbitrarily), or NULL on failure
+  */
+vertex_t *graph_nearest_vertex(spatial_index_t const *index, int x, int y)
+{
+	const spatial_point_t *best = NULL;
+	size_t best_d = (size_t)-1;
+	point_t q;
+
+	if (!index || !index->nb_points)
+		return (NULL);
+
+	q.x = x;
+	q.y = y;
+	best = index->points;
+	best_d = spatialDist(best, x, y);
+	spatialNearest(index->points, 0, index->nb_points, 0, &q,
+		       &best, &best_d);
+
+	return (best->vertex);
+}
+
+
+/**
+  * spatialRadius - collects the tree points within a squared distance of a
+  *   query point, skipping subtrees entirely out of range
+  *
+  * @pts: tree points
+  * @lo: first index of the subtree's range
+  * @hi: one past the last index of the subtree's range
+  * @axis: splitting axis of the subtree's root
+  * @q: query point
+  * @r2: squared radius
+  * @out: buffer receiving the matching vertices
+  * @max: length of @out
+  * @found: amount of matching vertices so far, updated in place
+  */
+static void spatialRadius(const spatial_point_t *pts, size_t lo, size_t hi,
+			  int axis, const point_t *q, size_t r2,
+			  vertex_t **out, size_t max, size_t *found)
+{
+	size_t mid;
+	long delta;
+
+	if (lo >= hi)
+		return;
+
+	mid = lo + (hi - lo) / 2;
+	if (spatialDist(pts + mid, q->x, q->y) <= r2)
+	{
+		if (out && *found < max)
+			out[*found] = pts[mid].vertex;
+		(*found)++;
+	}
+	delta = axis ? (long)q->y - pts[mid].y : (long)q->x - pts[mid].x;
+	if (delta <= 0 || spatialSquare(delta) <= r2)
+		spatialRadius(pts, lo, mid, !axis, q, r2, out, max, found);
+	if (delta >= 0 || spatialSquare(delta) <= r2)
+		spatialRadius(pts, mid + 1, hi, !axis, q, r2, out, max, found);
+}
+
+
+/**
+  * graph_vertices_in_radius - finds every indexed vertex within a distance of
+  *   a point, in no particular order
+  *
+  * @index: pointer to the spatial index
+  * @x: X coordinate of the point
+  * @y: Y coordinate of the point
+  * @radius: maximum Euclidean distance to the point, inclusive
+  * @out: buffer receiving pointers to the matching vertices, may be NULL
+  *   to only count them
+  * @max: length of @out
+  * Return: amount of matching vertices, which may exceed @max, in which case
+  *   only the first @max are stored
+  */
+size_t graph_vertices_in_radius(spatial_index_t const *index, int x, int y,
+				size_t radius, vertex_t **out, size_t max)
+{
+	size_t found = 0, r2;
+	point_t q;
+
+	if (!index)
+		return (0);
+
+	q.x = x;
+	q.y = y;
+	r2 = radius > 0xffffffffUL ? (size_t)-1 : radius * radius;
+	spatialRadius(index->points, 0, index->nb_points, 0, &q, r2,
+		      out, max, &found);
+
+	return (found);
+}
+
+
+/**
+  * spatial_index_delete - deallocates a spatial index; the indexed graph is
+  *   left untouched
+  *
+  * @index: pointer to the index to delete
+  */
+void spatial_index_delete(spatial_index_t *index)
+{
+	if (!index)
+		return;
+
+	free(index->points);
+	free(index);
+}
@@ -0,0 +1,63 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "pathfinding.h"
+
+/**
+ * main - Compares the heuristics available to A*, and runs A* with each
+ *
+ * Return: Either EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+    const char *names[] = {"zero", "manhattan", "octile", "chebyshev",
+                           "euclidean_sq", "euclidean"};
+    graph_t *graph;
+    vertex_t *start, *target;
+    size_t dist[8], n, i;
+    queue_t *path;
+    int h;
+
+    graph = graph_create();
+    graph_add_vertex(graph, "San Francisco", 37, -122);
+    graph_add_vertex(graph, "Los Angeles", 34, -118);
+    graph_add_vertex(graph, "Las Vegas", 36, -115);
+    start = graph_add_vertex(graph, "Seattle", 47, -122);
+    graph_add_vertex(graph, "Chicago", 41, -87);
+    graph_add_vertex(graph, "Washington", 38, -77);
+    graph_add_vertex(graph, "New York", 40, -74);
+    graph_add_vertex(graph, "Houston", 29, -95);
+    graph_add_vertex(graph, "Nashville", 36, -86);
+    target = graph_add_vertex(graph, "Miami", 25, -80);
+    graph_add_edge(graph, "Seattle", "San Francisco", 680, UNIDIRECTIONAL);
+    graph_add_edge(graph, "Seattle", "Chicago", 1734, UNIDIRECTIONAL);
+    graph_add_edge(graph, "Seattle", "Las Vegas", 1867, UNIDIRECTIONAL);
+    graph_add_edge(graph, "Seattle", "Houston", 2338, UNIDIRECTIONAL);
+    graph_add_edge(graph, "Seattle", "Nashville", 2345, UNIDIRECTIONAL);
+    graph_add_edge(graph, "Nashville", "Miami", 818, UNIDIRECTIONAL);
+
+    for (h = HEURISTIC_ZERO; h <= HEURISTIC_EUCLIDEAN; h++)
+    {
+        printf("%s from Seattle to Miami: %lu\n", names[h],
+               heuristic_dist(h, start, target));
+        n = heuristic_edges(h, start, target, dist, 8);
+        printf(" neighbors:");
+        for (i = 0; i < n; i++)
+            printf(" %lu", dist[i]);
+        printf("\n");
+    }
+
+    path = a_star_graph_heuristic(graph, start, target, HEURISTIC_MANHATTAN);
+    if (!path)
+    {
+        fprintf(stderr, "Failed to retrieve path\n");
+        graph_delete(graph);
+        return (EXIT_FAILURE);
+    }
+    while (path->front)
+        free(dequeue(path));
+    free(path);
+    graph_delete(graph);
+
+    return (EXIT_SUCCESS);
+}
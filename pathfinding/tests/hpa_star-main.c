@@ -0,0 +1,105 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "pathfinding.h"
+
+/**
+ * print_free_path - Unstacks the queue to discover the path from the starting
+ * point to the target point. Also deallocates the queue.
+ *
+ * @path: Queue containing the path
+ */
+static void print_free_path(queue_t *path)
+{
+    size_t len = 0;
+
+    printf("Path found:\n");
+    while (path->front)
+    {
+        point_t *point = (point_t *)dequeue(path);
+        printf(" [%d, %d]\n", point->x, point->y);
+        free(point);
+        len++;
+    }
+    printf("%lu cells\n", len);
+    free(path);
+}
+
+/**
+ * main - Hierarchical pathfinding on the maze of 0-main.c, split into 7x7
+ * clusters, then again after a corridor gets walled off
+ *
+ * Return: Either EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+    char rows[21][22] = {
+        "111111111111111111111",
+        "101000000000001000001",
+        "101011111111101110101",
+        "100010000010001000101",
+        "111111111010111011101",
+        "101000000010100010001",
+        "101011111010111011111",
+        "101000001010001000001",
+        "101110111011101111101",
+        "101000001000100000101",
+        "101011111110111110101",
+        "101000000010000010001",
+        "101111101111101111101",
+        "000000001000001000001",
+        "111011111010101011111",
+        "100010100010101000001",
+        "101110101111111110111",
+        "100000101000000000001",
+        "101111101011111111101",
+        "100000100000000010001",
+        "111110111111111111111"
+    };
+    char *map[21];
+    point_t start = { 0, 13 };
+    point_t target = { 5, 20 };
+    hpa_t *hpa;
+    queue_t *path;
+    int i;
+
+    for (i = 0; i < 21; i++)
+        map[i] = rows[i];
+    hpa = hpa_create(map, 21, 21, 7);
+    if (!hpa)
+    {
+        fprintf(stderr, "Failed to create hierarchical map\n");
+        return (EXIT_FAILURE);
+    }
+
+    path = hpa_path(hpa, &start, &target);
+    if (!path)
+    {
+        fprintf(stderr, "Failed to retrieve path\n");
+        hpa_delete(hpa);
+        return (EXIT_FAILURE);
+    }
+    print_free_path(path);
+
+    /* Wall off the corridor leading down to the exit */
+    hpa_set_cell(hpa, 5, 19, 1);
+    path = hpa_path(hpa, &start, &target);
+    printf("%s\n", path ? "Path still found" : "No path any more");
+    if (path)
+        print_free_path(path);
+
+    /* And open it again */
+    hpa_set_cell(hpa, 5, 19, 0);
+    path = hpa_path(hpa, &start, &target);
+    if (!path)
+    {
+        fprintf(stderr, "Failed to retrieve path\n");
+        hpa_delete(hpa);
+        return (EXIT_FAILURE);
+    }
+    print_free_path(path);
+
+    hpa_delete(hpa);
+    return (EXIT_SUCCESS);
+}
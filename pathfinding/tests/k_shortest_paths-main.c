@@ -0,0 +1,77 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "pathfinding.h"
+
+/**
+ * print_paths - Prints the paths found, using the vertex names
+ *
+ * @graph: Graph the paths were found in
+ * @paths: Paths to print
+ */
+static void print_paths(graph_t *graph, k_paths_t *paths)
+{
+    vertex_t *vertex;
+    size_t i, j;
+
+    for (i = 0; i < paths->nb_paths; i++)
+    {
+        printf("Path %lu (cost %lu):", i, paths->paths[i].cost);
+        for (j = 0; j < paths->paths[i].nb_vertices; j++)
+        {
+            for (vertex = graph->vertices; vertex; vertex = vertex->next)
+                if (vertex->index == paths->paths[i].vertices[j])
+                    printf(" %s", vertex->content);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * main - Finds alternative routes with Yen's algorithm
+ *
+ * Return: Either EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+    graph_t *graph;
+    vertex_t *start, *target;
+    k_paths_t *paths;
+
+    graph = graph_create();
+    graph_add_vertex(graph, "San Francisco", 37, -122);
+    graph_add_vertex(graph, "Los Angeles", 34, -118);
+    graph_add_vertex(graph, "Las Vegas", 36, -115);
+    start = graph_add_vertex(graph, "Seattle", 47, -122);
+    graph_add_vertex(graph, "Chicago", 41, -87);
+    graph_add_vertex(graph, "Washington", 38, -77);
+    graph_add_vertex(graph, "New York", 40, -74);
+    graph_add_vertex(graph, "Houston", 29, -95);
+    graph_add_vertex(graph, "Nashville", 36, -86);
+    target = graph_add_vertex(graph, "Miami", 25, -80);
+    graph_add_edge(graph, "San Francisco", "Los Angeles", 347, BIDIRECTIONAL);
+    graph_add_edge(graph, "San Francisco", "Las Vegas", 417, BIDIRECTIONAL);
+    graph_add_edge(graph, "Los Angeles", "Las Vegas", 228, BIDIRECTIONAL);
+    graph_add_edge(graph, "San Francisco", "Seattle", 680, BIDIRECTIONAL);
+    graph_add_edge(graph, "Seattle", "Chicago", 1734, BIDIRECTIONAL);
+    graph_add_edge(graph, "Chicago", "Washington", 594, BIDIRECTIONAL);
+    graph_add_edge(graph, "Washington", "New York", 203, BIDIRECTIONAL);
+    graph_add_edge(graph, "Las Vegas", "Houston", 1227, BIDIRECTIONAL);
+    graph_add_edge(graph, "Houston", "Nashville", 666, BIDIRECTIONAL);
+    graph_add_edge(graph, "Nashville", "Washington", 566, BIDIRECTIONAL);
+    graph_add_edge(graph, "Nashville", "Miami", 818, BIDIRECTIONAL);
+
+    paths = k_shortest_paths(graph, start, target, 5);
+    if (!paths)
+    {
+        fprintf(stderr, "Failed to retrieve paths\n");
+        graph_delete(graph);
+        return (EXIT_FAILURE);
+    }
+
+    print_paths(graph, paths);
+    k_paths_delete(paths);
+    graph_delete(graph);
+
+    return (EXIT_SUCCESS);
+}
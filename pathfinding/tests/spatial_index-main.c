@@ -0,0 +1,52 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "pathfinding.h"
+
+/**
+ * main - Snaps points to the nearest vertices of a graph
+ *
+ * Return: Either EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+    graph_t *graph;
+    spatial_index_t *index;
+    vertex_t *nearest, *around[10];
+    size_t i, found;
+
+    graph = graph_create();
+    graph_add_vertex(graph, "San Francisco", 37, -122);
+    graph_add_vertex(graph, "Los Angeles", 34, -118);
+    graph_add_vertex(graph, "Las Vegas", 36, -115);
+    graph_add_vertex(graph, "Seattle", 47, -122);
+    graph_add_vertex(graph, "Chicago", 41, -87);
+    graph_add_vertex(graph, "Washington", 38, -77);
+    graph_add_vertex(graph, "New York", 40, -74);
+    graph_add_vertex(graph, "Houston", 29, -95);
+    graph_add_vertex(graph, "Nashville", 36, -86);
+    graph_add_vertex(graph, "Miami", 25, -80);
+
+    index = spatial_index_create(graph);
+    if (!index)
+    {
+        fprintf(stderr, "Failed to create spatial index\n");
+        graph_delete(graph);
+        return (EXIT_FAILURE);
+    }
+
+    nearest = graph_nearest_vertex(index, 45, -120);
+    printf("Nearest to [45, -120]: %s\n", nearest->content);
+    nearest = graph_nearest_vertex(index, 39, -76);
+    printf("Nearest to [39, -76]: %s\n", nearest->content);
+
+    found = graph_vertices_in_radius(index, 38, -80, 7, around, 10);
+    printf("Within 7 of [38, -80]: %lu\n", found);
+    for (i = 0; i < found && i < 10; i++)
+        printf(" %s\n", around[i]->content);
+
+    spatial_index_delete(index);
+    graph_delete(graph);
+
+    return (EXIT_SUCCESS);
+}